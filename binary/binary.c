@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include "binary.h"
 #include "elf.h"
+#include "parser_linear.h"
 
 void initialize_binary(Binary* binary) {
 	binary->path = NULL;
@@ -146,12 +147,21 @@ static void binary_x64_elf_terminate(Binary* restrict binary) {
 bool binary_x64(
 Binary* restrict binary,
 const Parser* restrict parser) {
+	// the nodes are read in the order of the code
+	ParserLinear linear;
+	parser_initialize_linear(&linear);
+
+	if(!parser_create_linear(
+		parser,
+		&linear))
+		return false;
+
 	binary_x64_elf_initialize(binary);
 
 	for(size_t i = 0;
-	i < parser->nodes.count - 1;
+	i < linear.count_nodes;
 	++i) {
-		// const Node* node = &parser->nodes[i];
+		// const Node* node = &((const ParserLinearNode*) linear.nodes.addr)[i].node;
 /*
 		if(node->type == NodeType_CORE_B) {
 			APPEND_BYTE(node->value);
@@ -159,6 +169,7 @@ const Parser* restrict parser) {
 	}
 
 	binary_x64_elf_terminate(binary);
+	parser_destroy_linear(&linear);
 	return true;
 }
 
@@ -4,10 +4,33 @@
 #include <stdio.h>
 #include "debug.h"
 #include "parser_allocator.h"
+#include "parser_linear.h"
+#include "parser_qualifier.h"
+
+static void print_info_literal_number(
+const Lexer* lexer,
+const Token* token) {
+	const Literal* literal = (const Literal*) lexer->literals.addr + token->literal;
+
+	if(literal->count_words == 0) {
+		printf(" = %" PRIu64, literal->value);
+		return;
+	}
+
+	const uint64_t* words = (const uint64_t*) lexer->literal_words.addr + literal->value;
+	printf(" = 0x%" PRIX64, words[literal->count_words - 1]);
+
+	for(size_t i = literal->count_words - 1;
+	i > 0;
+	i -= 1) {
+		printf("%016" PRIX64, words[i - 1]);
+	}
+}
 
 static void print_info_token(
-const char* code,
+const Lexer* lexer,
 const Token* token) {
+	const char* code = lexer->source->content;
 	const char* type;
 
 	switch(token->type) {
@@ -82,15 +105,27 @@ const Token* token) {
 			printf("CHR"); break;
 		}
 
-		printf("\t<%.*s>\n",
+		printf("\t<%.*s>",
 			(int) (token->end - token->start),
 			code + token->start);
+
+		if(token->subtype == TokenSubtype_LITERAL_NUMBER)
+			print_info_literal_number(
+				lexer,
+				token);
+		else
+			printf(" #%zu", token->literal);
+
+		printf("\n");
 	}
 }
 
 static void print_info_node_key_identification(
-const char* code,
+const Parser* parser,
 const Node* node) {
+	const char* code = parser->lexer->source->content;
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	const Token* token = tokens + node->token;
 	bool is_initialization = false;
 
 	if((node->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_COMMAND)
@@ -112,8 +147,8 @@ const Node* node) {
 	}
 
 	printf(" <%.*s>",
-		(int) (node->token->L_end - node->token->L_start),
-		code + node->token->L_start);
+		(int) (token->L_end - token->L_start),
+		code + token->L_start);
 
 	if((node->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED)
 	== NodeSubtypeIdentificationBitScoped_LABEL) {
@@ -126,35 +161,74 @@ const Node* node) {
 	if(is_initialization) {
 		if(node->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED) {
 			printf(
-				" (SCOPE ID: %p)",
+				" (SCOPE ID: %" PRIu32 ")",
 				node->child2);
-		} else {
+		} else if(parser_allocator_node(
+			parser,
+			node->child2)->type == NodeType_LITERAL) {
+			const Token* literal = tokens + parser_allocator_node(
+				parser,
+				node->child2)->token;
 			printf(
 				" <%.*s>",
-				(int) (node->child2->token->L_end - node->child2->token->L_start),
-				code + node->child2->token->L_start);
+				(int) (literal->L_end - literal->L_start),
+				code + literal->L_start);
+		} else {
+			printf(
+				" (EXPRESSION ID: %" PRIu32 ")",
+				node->child2);
 		}
 	}
 
 	printf("\n");
 }
 
-static void print_info_node_type(
-const char* code,
-const Node* node) {
-	const Token* token = node->token;
+// the ones with a bit, then the others in their order
+static void print_info_node_qualifiers(
+const Parser* parser,
+uint32_t index) {
+	const char* code = parser->lexer->source->content;
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	const NodeSubtype subtype = parser_allocator_node(
+		parser,
+		index)->subtype;
 
-	switch(node->type) {
-	case NodeType_QUALIFIER:
-		if(node->subtype == TokenType_QL) {
-			printf("QL <%.*s>\n",
+	if(subtype & NodeSubtypeIdentificationBitQualifier_MUT)
+		printf("\t\tQL <mut>\n");
+
+	if(subtype & NodeSubtypeIdentificationBitQualifier_ENTRY)
+		printf("\t\tQL <entry>\n");
+
+	size_t count;
+	const ParserQualifier* qualifiers = parser_qualifier_find(
+		index,
+		parser,
+		&count);
+
+	for(size_t i = 0;
+	i < count;
+	i += 1) {
+		const Token* token = tokens + qualifiers[i].token;
+
+		if(token->subtype == (TokenSubtype) TokenType_QL) {
+			printf("\t\tQL <%.*s>\n",
 				(int) (token->L_end - token->L_start),
 				code + token->L_start);
 		} else {
-			printf("QR <%.*s>\n",
+			printf("\t\tQR <%.*s>\n",
 				(int) (token->R_end - token->R_start),
 				code + token->R_start);
-		} break;
+		}
+	}
+}
+
+static void print_info_node_type(
+const Parser* parser,
+const Node* node) {
+	const char* code = parser->lexer->source->content;
+	const Token* token = (const Token*) parser->lexer->tokens.addr + node->token;
+
+	switch(node->type) {
 	case NodeTypeChildType_LOCK:
 		switch(node->subtype) {
 			case NodeSubtypeChild_NO:
@@ -185,7 +259,7 @@ void debug_print_tokens(const Lexer* lexer) {
 	i += 1) {
 		printf("\t");
 		print_info_token(
-			lexer->source->content,
+			lexer,
 			(Token*) lexer->tokens.addr + i);
 	}
 
@@ -194,73 +268,72 @@ void debug_print_tokens(const Lexer* lexer) {
 		lexer->tokens.count);
 }
 
-void debug_print_declarations(const Parser* parser) {
-	const char* code = parser->lexer->source->content;
-	const MemoryChainLink* link;
-	const Node* node = parser_allocator_start_declaration(
-		parser,
-		&link);
-	size_t count = 0;
-	printf("DECLARATIONS:\n");
+void debug_print_strings(const Lexer* lexer) {
+	const LiteralString* strings = (const LiteralString*) lexer->strings.addr;
+	const char* data = (const char*) lexer->string_data.addr;
+	printf("STRINGS:\n");
 
-	if(node == NULL)
-		return;
+	for(size_t i = 1;
+	i < lexer->count_strings;
+	i += 1) {
+		printf("\t#%zu <%.*s> id %" PRIu32 "\n",
+			i,
+			(int) strings[i].length,
+			data + strings[i].start,
+			strings[i].id);
+	}
 
-	while(parser_allocator_continue_declaration(
-		parser,
-		node)
-	== true) {
-		if(node->type == NodeType_NO)
-			break;
+	printf(
+		"\nNumber of unique strings: %zu.\n",
+		lexer->count_strings - 1);
+}
 
-		printf("\t");
+void debug_print_declarations(const Parser* parser) {
+	const ParserSymbol* symbols = (const ParserSymbol*) parser->symbols.symbols.addr;
+	printf("DECLARATIONS:\n");
 
+	for(size_t i = 0;
+	i < parser->symbols.count_symbols;
+	i += 1) {
+		const Node* node = parser_allocator_node(
+			parser,
+			symbols[i].node);
+		printf("\t");
 		print_info_node_key_identification(
-			parser->lexer->source->content,
+			parser,
 			node);
-		const Node* child1 = node->child1;
+		print_info_node_qualifiers(
+			parser,
+			symbols[i].node);
 
-		do {
-			parser_allocator_next_link(
-				node,
-				&link);
+		for(uint32_t child1 = node->child1;
+		child1 != 0;
+		child1 = parser_allocator_node(
+			parser,
+			child1)->child1) {
 			printf("\t\t");
 			print_info_node_type(
-				code,
-				child1);
-			node = child1;
-			child1 = node->child1;
-		} while(child1 != NULL);
-
-		count += 1;
-
-		if(parser_allocator_next(
-			parser,
-			&link,
-			&node)
-		== false)
-			break;
+				parser,
+				parser_allocator_node(
+					parser,
+					child1));
+		}
 	}
 
-	printf("\nNumber of declarations at file scope: %zu\n", count);
+	printf("\nNumber of declarations at file scope: %zu\n", parser->symbols.count_symbols);
 }
 
 void debug_print_nodes(const Parser* parser) {
 	const char* code = parser->lexer->source->content;
-	const MemoryChainLink* link;
-	const Node* node = parser_allocator_start_node(
-		parser,
-		&link);
-	size_t count = 0;
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	const Node* nodes = (const Node*) parser->nodes.addr;
 	printf("NODES:\n");
-
-	if(node == NULL)
-		return;
-
-	while(parser_allocator_continue_node(
-		parser,
-		node)
-	== true) {
+	// the children of a node follow it, the first node is null
+	for(uint32_t i = 1;
+	i < parser->count_nodes;
+	i += 1) {
+		const Node* node = nodes + i;
+		const Token* token = tokens + node->token;
 		printf("\t");
 
 		if(node->type == NodeType_MODULE) {
@@ -270,76 +343,150 @@ void debug_print_nodes(const Parser* parser) {
 				printf("OMOD ");
 
 			printf("<%.*s>\n",
-				(int) (node->token->L_end - node->token->L_start),
-				code + node->token->L_start);
-			const Node* child = node->child;
-
-			while(child != NULL) {
-				if(node == (Node*) link->memArea.addr + link->memArea.count - 1)
-					link = link->next;
+				(int) (token->L_end - token->L_start),
+				code + token->L_start);
 
+			for(uint32_t child = node->child;
+			child != 0;
+			child = nodes[child].child) {
+				token = tokens + nodes[child].token;
 				printf("\t\tSUBMOD <%.*s>\n",
-					(int) (child->token->L_end - child->token->L_start),
-					code + child->token->L_start);
-				node = child;
-				child = child->child;
-				count += 1;
+					(int) (token->L_end - token->L_start),
+					code + token->L_start);
+				i = child;
 			}
-
-			count += 1;
 		} else if(node->type == NodeType_SCOPE_START) {
 			printf(
-				"SCOPE START (%td NODES) ID: %p\n",
+				"SCOPE START (%" PRIu32 " NODES) ID: %" PRIu32 "\n",
 				node->value - 1,
-				node);
-			count += 1;
+				i);
 		} else if(node->type == NodeType_IDENTIFICATION) {
 			print_info_node_key_identification(
-				code,
+				parser,
 				node);
-			const Node* child1 = node->child1;
+			print_info_node_qualifiers(
+				parser,
+				i);
 
-			do {
-				parser_allocator_next_link(
-					node,
-					&link);
+			for(uint32_t child1 = node->child1;
+			child1 != 0;
+			child1 = nodes[child1].child1) {
 				printf("\t\t");
 				print_info_node_type(
-					code,
-					child1);
-				node = child1;
-				child1 = node->child1;
-				count += 1;
-			} while(child1 != NULL);
-
-			count += 1;
+					parser,
+					nodes + child1);
+				// a shared type was printed with its first identification
+				if(child1 > i)
+					i = child1;
+			}
 		} else if(node->type == NodeType_SCOPE_END) {
 			printf("SCOPE END\n");
-			count += 1;
+		} else if(node->type == NodeType_CALL) {
+			const bool is_R = token->type == TokenType_R;
+			printf(
+				"CALL <%.*s> ID: %" PRIu32,
+				(int) (is_R ? token->R_end - token->R_start : token->L_end - token->L_start),
+				code + (is_R ? token->R_start : token->L_start),
+				node->child1);
+
+			if(node->child2 != 0)
+				printf(" (ARGUMENT ID: %" PRIu32 ")", node->child2);
+
+			printf("\n");
+		} else if(node->type == NodeType_EXPRESSION) {
+			if(node->subtype == NodeSubtypeExpression_KEY) {
+				const bool is_R = token->type == TokenType_R;
+				printf(
+					"KEY <%.*s> ID: %" PRIu32 "\n",
+					(int) (is_R ? token->R_end - token->R_start : token->L_end - token->L_start),
+					code + (is_R ? token->R_start : token->L_start),
+					node->child1);
+			} else if(node->subtype == NodeSubtypeExpression_ARGUMENT) {
+				printf(
+					"ARGUMENT (%" PRIu32 ", NEXT %" PRIu32 ")\n",
+					node->child1,
+					node->child2);
+			} else if(node->child2 == 0) {
+				printf(
+					"PREFIX <%.*s> (%" PRIu32 ")\n",
+					(int) (token->L_end - token->L_start),
+					code + token->L_start,
+					node->child1);
+			} else {
+				printf(
+					"OPERATOR <%.*s> (%" PRIu32 ", %" PRIu32 ")\n",
+					(int) (token->L_end - token->L_start),
+					code + token->L_start,
+					node->child1,
+					node->child2);
+			}
 		} else if(node->type == NodeType_LITERAL) {
 			print_info_token(
-				code,
-				node->token);
-			count += 1;
+				parser->lexer,
+				token);
 		} else {
 			printf(
-				"%" PRIu64 ", %" PRIu64 "\n",
+				"%" PRIu8 ", %" PRIu16 "\n",
 				node->type,
 				node->subtype);
-			count += 1;
 		}
-
-		if(parser_allocator_next(
-			parser,
-			&link,
-			&node)
-		== false)
-			break;
 	}
 
 	printf(
 		"\nNumber of nodes: %zu.\n",
-		count);
+		parser->count_nodes - 1);
+}
+
+static ParserVisit print_tree_node(
+const ParserLinearNode* entry,
+size_t depth,
+void*) {
+	static const char* const names[COUNT_NODE_TYPE] = {
+		[NodeType_NO] = "NO",
+		[NodeType_MODULE] = "MODULE",
+		[NodeType_SCOPE_START] = "SCOPE START",
+		[NodeType_SCOPE_END] = "SCOPE END",
+		[NodeType_IDENTIFICATION] = "IDENTIFICATION",
+		[NodeType_CALL] = "CALL",
+		[NodeType_LITERAL] = "LITERAL",
+		[NodeType_EXPRESSION] = "EXPRESSION"};
+
+	printf(
+		"\t%*s%s ID: %" PRIu32 " (%" PRIu32 " NODES)\n",
+		(int) depth * 2,
+		"",
+		entry->node.is_child ? "LINK" : names[entry->node.type],
+		entry->id,
+		entry->size);
+	return ParserVisit_CONTINUE;
+}
+
+void debug_print_tree(const Parser* parser) {
+	ParserLinear linear;
+	ParserVisitor visitor = {
+		.pre_link = print_tree_node};
+	parser_initialize_linear(&linear);
+	printf("TREE:\n");
+
+	for(size_t i = 0;
+	i < COUNT_NODE_TYPE;
+	i += 1) visitor.pre[i] = print_tree_node;
+
+	if(!parser_create_linear(
+		parser,
+		&linear)
+	|| parser_visit(
+		parser,
+		&linear,
+		&visitor,
+		NULL)
+	== -1)
+		printf("\tcannot flatten the nodes\n");
+
+	printf(
+		"\nNumber of entries: %zu.\n",
+		linear.count_nodes);
+	parser_destroy_linear(&linear);
 }
 
 #endif
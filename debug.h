@@ -6,7 +6,9 @@
 #include "parser.h"
 
 void debug_print_tokens(const Lexer* lexer);
+void debug_print_strings(const Lexer* lexer);
 void debug_print_nodes(const Parser* parser);
+void debug_print_tree(const Parser* parser);
 void debug_print_declarations(const Parser* parser);
 
 #endif
@@ -0,0 +1,74 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "allocator.h"
+
+/*
+ * string interner shared by the lexers of several threads, so that the IDs agree across modules
+ * - the entries are allocated in blocks, each one doubling the capacity, so an entry never moves
+ * - a full interner grows with every stripe locked, its IDs rehashed in a new table;
+ *   the tables replaced are kept until the interner is destroyed for the lookups still reading them
+ * - a lookup is lock-free: the ID of a slot is published after its entry is written
+ * - an insertion locks the stripe of its hash, so equal strings are never inserted twice,
+ *   and claims its slot with a compare-and-swap because the stripes share the table
+ * - the strings are copied in an arena per stripe
+ * 0 is the ID of no string.
+*/
+
+#define COUNT_INTERNER_STRIPE 16
+#define COUNT_INTERNER_BLOCK 32
+// initial capacity of an interner, which does not depend on the sources
+#define CAPACITY_INTERNER 4096
+
+typedef struct {
+	const char* string; // followed by a null character
+	size_t length;
+	uint64_t hash;
+} InternerEntry;
+
+typedef struct {
+	pthread_mutex_t lock;
+	MemoryChain arena; // of characters
+	size_t count_arena; // used in the last area
+} InternerStripe;
+
+typedef struct InternerTable InternerTable;
+
+struct InternerTable {
+	InternerTable* previous; // replaced by this one
+	size_t count; // power of 2, at least twice `Interner.capacity`
+	_Atomic uint32_t slots[];
+};
+
+typedef struct {
+	_Atomic(InternerTable*) table;
+	InternerEntry* blocks[COUNT_INTERNER_BLOCK]; // the first one of `1 << shift_block` entries, then as many as before
+	size_t count_blocks;
+	size_t shift_block;
+	size_t capacity; // IDs with an entry, only changed with every stripe locked
+	atomic_uint_least32_t count; // next ID
+	InternerStripe stripes[COUNT_INTERNER_STRIPE];
+} Interner;
+
+void initialize_interner(Interner* interner);
+bool create_interner(
+	size_t capacity,
+	Interner* interner);
+uint32_t interner_find(
+	const char* string,
+	size_t length,
+	uint64_t hash,
+	const Interner* interner);
+uint32_t interner_intern(
+	const char* string,
+	size_t length,
+	uint64_t hash,
+	Interner* interner);
+const InternerEntry* interner_get(
+	uint32_t id,
+	const Interner* interner);
+void destroy_interner(Interner* interner);
+
+#endif
@@ -6,6 +6,7 @@
 
 #include "allocator.h"
 #include "binary.h"
+#include "interner.h"
 #include "lexer.h"
 #include "parser.h"
 #include "source.h"
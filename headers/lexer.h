@@ -2,14 +2,28 @@
 #define LEXER_H
 
 #include "allocator.h"
+#include "interner.h"
 #include "lexer_def.h"
 #include "source.h"
 
 void initialize_lexer(Lexer* lexer);
 bool create_lexer(
 	const Source* source,
+	Interner* interner,
 	MemoryArea* restrict memArea,
 	Lexer* lexer);
+bool create_lexer_stream(
+	const Source* source,
+	Interner* interner,
+	MemoryArea* restrict memArea,
+	size_t lookahead,
+	Lexer* lexer);
+const Token* lexer_stream_get(
+	size_t index,
+	Lexer* lexer);
+void lexer_stream_release(
+	size_t index,
+	Lexer* lexer);
 void destroy_lexer(Lexer* lexer);
 
 #endif
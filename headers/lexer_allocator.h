@@ -3,10 +3,24 @@
 
 #include "lexer_def.h"
 
-bool lexer_create_allocator(Lexer* lexer);
+bool lexer_create_allocator(
+	size_t count,
+	Lexer* lexer);
 bool lexer_allocator(
 	size_t minimum,
 	Lexer* lexer);
+bool lexer_allocator_literal(
+	size_t minimum,
+	Lexer* lexer);
+bool lexer_allocator_literal_word(
+	size_t minimum,
+	Lexer* lexer);
+bool lexer_allocator_string(
+	size_t minimum,
+	Lexer* lexer);
+bool lexer_allocator_string_data(
+	size_t minimum,
+	Lexer* lexer);
 bool lexer_allocator_shrink(Lexer* lexer);
 void lexer_destroy_allocator(Lexer* lexer);
 
@@ -0,0 +1,11 @@
+#ifndef LEXER_CACHE_H
+#define LEXER_CACHE_H
+
+#include "lexer_def.h"
+
+const char* lexer_cache_directory(void);
+bool lexer_cache_load(Lexer* lexer);
+bool lexer_cache_store(const Lexer* lexer);
+void lexer_cache_unmap(Lexer* lexer);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "allocator.h"
+#include "interner.h"
 #include "source.h"
 
 typedef enum: uint32_t {
@@ -83,10 +84,13 @@ typedef enum: uint32_t {
 typedef struct {
 	uint32_t type;
 	uint32_t subtype;
+	uint32_t L_name; // index in `Lexer.strings` of the name on the left (0 if none)
+	uint32_t R_name;
 	union {
 		struct {
 			long int start;
-			long int end;};
+			long int end;
+			size_t literal;}; // index in `Lexer.literals` for a number, in `Lexer.strings` otherwise
 		struct {
 			long int L_start;
 			long int L_end;
@@ -94,9 +98,62 @@ typedef struct {
 			long int R_end;};};
 } Token;
 
+/*
+ * a number literal is decoded once by the lexer
+ * if it does not fit in 64 bits, `value` is the index of its first word in `Lexer.literal_words`
+ * and the words are stored from the least significant one
+*/
+
+typedef struct {
+	uint64_t value;
+	uint32_t count_words; // 0 if the value fits in 64 bits
+	uint32_t base;
+} Literal;
+
+/*
+ * string and character literals are decoded once in `Lexer.string_data` and deduplicated,
+ * the names share the same pool
+ * `Lexer.string_table` is an open addressing table of indexes in `Lexer.strings` (0 is empty)
+ * a string of the pool is also interned in `Lexer.interner`, which may be shared by other lexers
+*/
+
+typedef struct {
+	size_t start; // followed by a null character
+	size_t length;
+	uint64_t hash;
+	uint32_t id; // in `Lexer.interner`, set again when loading a token file
+} LiteralString;
+
+// where the tokenization stopped
+typedef struct {
+	long int start;
+	long int end;
+	long int count_L_parenthesis_nest; // to get a good match with R parenthesis
+	size_t i; // index of the next token in `Lexer.tokens`
+} LexerScan;
+
 typedef struct {
 	const Source* source;
+	Interner* interner;
+	MemoryArea index; // `LexerIndexBlock` while tokenizing (see "lexer_index.h")
 	MemoryArea tokens;
+	MemoryArea literals;
+	size_t count_literals;
+	MemoryArea literal_words;
+	size_t count_literal_words;
+	MemoryArea strings;
+	size_t count_strings;
+	MemoryArea string_data;
+	size_t count_string_data;
+	MemoryArea string_table;
+	void* cache_addr; // the areas point in a mapped token file if not null
+	size_t cache_length;
+	LexerScan scan;
+	// token stream (see `create_lexer_stream`)
+	size_t stream_offset;
+	size_t stream_first;
+	size_t stream_lookahead;
+	bool stream_end;
 } Lexer;
 
 #endif
@@ -6,6 +6,7 @@
 
 bool lexer_scan_errors(
 	const Source* source,
+	const MemoryArea* index,
 	MemoryArea* memArea);
 
 #endif
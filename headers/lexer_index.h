@@ -0,0 +1,38 @@
+#ifndef LEXER_INDEX_H
+#define LEXER_INDEX_H
+
+#include "allocator.h"
+#include "source.h"
+
+/*
+ * structural index of a source, built before tokenizing
+ * a block describes 64 characters of `Source.content`, one bit per character,
+ * so that blanks are skipped by jumping to the next set bit and the neighbors of
+ * a character are checked without reading them
+*/
+
+typedef struct {
+	uint64_t graph;
+	uint64_t stop; // a glyph or a null character, where skipping blanks stops
+	uint64_t colon_invalid; // a colon with an invalid neighbor (see `lexer_scan_errors`)
+} LexerIndexBlock;
+
+bool lexer_create_index(
+	const Source* source,
+	MemoryArea* index);
+bool lexer_index_is_graph(
+	const MemoryArea* index,
+	long int i);
+bool lexer_index_is_colon_invalid(
+	const MemoryArea* index,
+	long int i);
+void lexer_index_skip_blanks(
+	const MemoryArea* index,
+	long int* end);
+bool lexer_index_get_next_word(
+	const MemoryArea* index,
+	const char* string,
+	long int* restrict start,
+	long int* restrict end);
+
+#endif
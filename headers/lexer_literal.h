@@ -0,0 +1,23 @@
+#ifndef LEXER_LITERAL_H
+#define LEXER_LITERAL_H
+
+#include "lexer_def.h"
+
+bool lexer_literal_number(
+	long int start,
+	long int end,
+	size_t* restrict literal,
+	Lexer* lexer);
+bool lexer_literal_string(
+	long int start,
+	long int end,
+	size_t* restrict literal,
+	Lexer* lexer);
+
+bool lexer_literal_name(
+	long int start,
+	long int end,
+	size_t* restrict literal,
+	Lexer* lexer);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef LEXER_PROFILE_H
+#define LEXER_PROFILE_H
+
+/*
+ * optional instrumentation of the lexer, built with `-DLEXER_PROFILE`
+ * it counts the hits and the bytes consumed (from the end of the previous word) by each rule,
+ * the created tokens by type and subtype, and the growths of the lexer areas
+ * without the flag, the macros compile to nothing
+*/
+
+#ifdef LEXER_PROFILE
+
+#include <stdio.h>
+#include "lexer_def.h"
+
+// the rules of `create_lexer` and the paths of the special case
+typedef enum: uint8_t {
+#define LEXER_PROFILE_RULE(rule) LexerProfileRule_ ## rule
+	LEXER_PROFILE_RULE(COMMAND) = 0,
+	LEXER_PROFILE_RULE(QL),
+	LEXER_PROFILE_RULE(L),
+	LEXER_PROFILE_RULE(QR),
+	LEXER_PROFILE_RULE(R),
+	LEXER_PROFILE_RULE(R_MODIFIER), // modifier operators following a R
+	LEXER_PROFILE_RULE(QLR),
+	LEXER_PROFILE_RULE(LR),
+	LEXER_PROFILE_RULE(PL),
+	LEXER_PROFILE_RULE(LITERAL),
+	LEXER_PROFILE_RULE(SPECIAL_R_MODIFIER),
+	LEXER_PROFILE_RULE(SPECIAL_R_PARENTHESIS),
+	LEXER_PROFILE_RULE(SPECIAL_R_GRAVE_ACCENT),
+	LEXER_PROFILE_RULE(SPECIAL_L_MODIFIER),
+	LEXER_PROFILE_RULE(SPECIAL_RPARENTHESIS),
+	LEXER_PROFILE_RULE(SPECIAL), // `TOKEN_SPECIAL`
+	LEXER_PROFILE_RULE(NAME),
+	LEXER_PROFILE_RULE(COUNT),
+#undef LEXER_PROFILE_RULE
+} LexerProfileRule;
+
+void lexer_profile_rule(LexerProfileRule rule);
+void lexer_profile_scan(
+	const Lexer* lexer,
+	long int end,
+	size_t i);
+void lexer_profile_growth(
+	size_t count_before,
+	size_t count,
+	size_t size_type);
+void lexer_profile_print(FILE* file);
+
+#define LEXER_PROFILE_RULE(rule) lexer_profile_rule(LexerProfileRule_ ## rule)
+#define LEXER_PROFILE_SCAN(lexer, end, i) lexer_profile_scan(lexer, end, i)
+#define LEXER_PROFILE_GROWTH(count_before, count, size_type) lexer_profile_growth(count_before, count, size_type)
+
+#else
+
+#define LEXER_PROFILE_RULE(rule)
+#define LEXER_PROFILE_SCAN(lexer, end, i)
+#define LEXER_PROFILE_GROWTH(count_before, count, size_type)
+
+#endif
+#endif
@@ -0,0 +1,71 @@
+#ifndef LEXER_TABLE_H
+#define LEXER_TABLE_H
+
+#include <stdint.h>
+
+/*
+ * the tables are generated by "tools/lexer_table.c" when building
+ * a character has a set of classes and belongs to exactly one equivalence,
+ * the rules which may create a token depend on the equivalences of the first two characters of a word
+*/
+
+typedef enum: uint16_t {
+#define LEXER_CLASS(class) LexerClass_ ## class
+	LEXER_CLASS(GRAPH) = 1 << 0,
+	LEXER_CLASS(ALPHA) = 1 << 1,
+	LEXER_CLASS(DIGIT) = 1 << 2,
+	LEXER_CLASS(XDIGIT) = 1 << 3, // uppercase only
+	LEXER_CLASS(NAME) = 1 << 4, // alpha, digit or underscore
+	LEXER_CLASS(SPECIAL) = 1 << 5,
+	LEXER_CLASS(INTERPRETED) = 1 << 6,
+	LEXER_CLASS(COMMAND) = 1 << 7,
+	LEXER_CLASS(OPERATOR_LEVELING) = 1 << 8,
+	LEXER_CLASS(BRACKET) = 1 << 9,
+	LEXER_CLASS(PARENTHESIS) = 1 << 10,
+	LEXER_CLASS(DELIMITER_OPEN) = 1 << 11,
+	LEXER_CLASS(DELIMITER_CLOSE) = 1 << 12,
+	LEXER_CLASS(COLON_INVALID_LEFT) = 1 << 13, // cannot be on the left of a colon
+	LEXER_CLASS(COLON_INVALID_RIGHT) = 1 << 14, // cannot be on the right of a colon (including the end)
+#undef LEXER_CLASS
+} LexerClass;
+
+typedef enum: uint8_t {
+#define LEXER_EQUIVALENCE(equivalence) LexerEquivalence_ ## equivalence
+	LEXER_EQUIVALENCE(NULL) = 0,
+	LEXER_EQUIVALENCE(BLANK),
+	LEXER_EQUIVALENCE(ALPHA),
+	LEXER_EQUIVALENCE(DIGIT),
+	LEXER_EQUIVALENCE(COLON),
+	LEXER_EQUIVALENCE(PERIOD),
+	LEXER_EQUIVALENCE(LBRACKET),
+	LEXER_EQUIVALENCE(COMMAND),
+	LEXER_EQUIVALENCE(QUOTE), // both quotes delimiting literals
+	LEXER_EQUIVALENCE(SPECIAL),
+	LEXER_EQUIVALENCE(GRAPH), // not special and cannot start a name
+	LEXER_EQUIVALENCE(COUNT),
+#undef LEXER_EQUIVALENCE
+} LexerEquivalence;
+
+// in the checking order of `create_lexer`
+typedef enum: uint16_t {
+#define LEXER_RULE(rule) LexerRule_ ## rule
+	LEXER_RULE(COMMAND) = 1 << 0,
+	LEXER_RULE(QL) = 1 << 1,
+	LEXER_RULE(L) = 1 << 2,
+	LEXER_RULE(QR) = 1 << 3,
+	LEXER_RULE(R) = 1 << 4,
+	LEXER_RULE(QLR) = 1 << 5,
+	LEXER_RULE(LR) = 1 << 6,
+	LEXER_RULE(PL) = 1 << 7,
+	LEXER_RULE(LITERAL) = 1 << 8,
+	LEXER_RULE(SPECIAL) = 1 << 9,
+	LEXER_RULE(NAME) = 1 << 10,
+#undef LEXER_RULE
+} LexerRule;
+
+extern const uint16_t lexer_classes[256];
+extern const uint8_t lexer_equivalences[256];
+extern const uint8_t lexer_subtypes[256]; // TokenSubtype of a special character
+extern const uint16_t lexer_rules[LexerEquivalence_COUNT][LexerEquivalence_COUNT];
+
+#endif
@@ -16,6 +16,10 @@ bool lexer_is_interpreted(char c);
 bool lexer_is_operator_leveling(char c);
 bool lexer_is_operator_modifier(char c);
 bool lexer_is_special(char c);
+bool lexer_is_graph(char c);
+uint16_t lexer_get_rules(
+	char first,
+	char second);
 bool lexer_delimiter_match(
 	char c1,
 	char c2);
@@ -36,6 +40,9 @@ bool lexer_get_next_word(
 	const char* string,
 	long int* restrict start,
 	long int* restrict end);
+uint64_t lexer_hash(
+	const char* string,
+	size_t length);
 bool lexer_skip_comment(
 	const char* string,
 	long int* restrict start,
@@ -9,8 +9,22 @@
 void initialize_parser(Parser* parser);
 bool create_parser(
 	const Lexer* lexer,
-	MemoryArea* restrict memArea,
 	Parser* parser);
+bool create_parser_incremental(
+	const Lexer* lexer,
+	const Parser* previous,
+	const ParserEdit* edits,
+	size_t count_edits,
+	Parser* parser);
+bool parser_parse_tokens(
+	size_t i,
+	size_t end,
+	Parser* parser);
+int parser_visit(
+	const Parser* parser,
+	const ParserLinear* linear,
+	const ParserVisitor* visitor,
+	void* data);
 void destroy_parser(Parser* parser);
 
 #endif
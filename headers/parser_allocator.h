@@ -8,24 +8,20 @@ void parser_initialize_allocators(Parser* parser);
 bool parser_create_allocators(Parser* parser);
 void parser_destroy_allocators(Parser* parser);
 bool parser_allocator(Parser* parser);
-void parser_allocator_next_link(
-	const Node* node,
-	const MemoryChainLink** link);
-bool parser_allocator_next(
+bool parser_allocator_reserve(
+	size_t count,
+	Parser* parser);
+bool parser_allocator_fixup(Parser* parser);
+bool parser_allocator_scope(Parser* parser);
+bool parser_allocator_nest(Parser* parser);
+bool parser_allocator_expression(
+	size_t count_operators,
+	size_t count_operands,
+	Parser* parser);
+bool parser_allocator_top(Parser* parser);
+uint32_t parser_allocator_index(const Parser* parser);
+Node* parser_allocator_node(
 	const Parser* parser,
-	const MemoryChainLink** link,
-	const Node** node);
-const Node* parser_allocator_start_node(
-	const Parser* parser,
-	const MemoryChainLink** link);
-bool parser_allocator_continue_node(
-	const Parser* parser,
-	const Node* node);
-const Node* parser_allocator_start_declaration(
-	const Parser* parser,
-	const MemoryChainLink** link);
-bool parser_allocator_continue_declaration(
-	const Parser* parser,
-	const Node* node);
+	uint32_t index);
 
 #endif
@@ -0,0 +1,10 @@
+#ifndef PARSER_CACHE_H
+#define PARSER_CACHE_H
+
+#include "parser_def.h"
+
+bool parser_cache_load(Parser* parser);
+bool parser_cache_store(const Parser* parser);
+void parser_cache_unmap(Parser* parser);
+
+#endif
@@ -3,8 +3,16 @@
 
 #include "parser_def.h"
 
+bool parser_call_bind(
+	uint32_t node,
+	Parser* parser);
 int if_call_create_nodes(
 	size_t* i,
 	Parser* parser);
+bool parser_call_resolve_unit(
+	const Parser* unit,
+	const uint32_t* map,
+	Parser* parser);
+bool parser_call_resolve(Parser* parser);
 
 #endif
@@ -1,17 +1,17 @@
 #ifndef PARSER_DEF
 #define PARSER_DEF
 
+#include <assert.h>
 #include <stdint.h>
 #include "allocator.h"
 #include "lexer_def.h"
 
-typedef enum: uint64_t {
+typedef enum: uint8_t {
 #define NODE_TYPE(type) NodeType_ ## type
 	NODE_TYPE(NO) = 0,
 	NODE_TYPE(MODULE),
 	NODE_TYPE(SCOPE_START), // `.child` holds the ending scope node
 	NODE_TYPE(SCOPE_END),
-	NODE_TYPE(QUALIFIER),
 	NODE_TYPE(IDENTIFICATION), // `.subtype` holds the command, the type of identification and the qualifiers
 	NODE_TYPE(CALL),
 	NODE_TYPE(LITERAL),
@@ -19,25 +19,25 @@ typedef enum: uint64_t {
 #undef NODE_TYPE
 } NodeType;
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtype_ ## subtype
 	NODE_SUBTYPE(NO) = 0,
 #undef NODE_SUBTYPE
 } NodeSubtype;
 
-typedef enum: uint64_t {
+typedef enum: uint8_t {
 #define NODE_TYPE_CHILD(type) NodeTypeChild_ ## type
 	NODE_TYPE_CHILD(NO) = 0,
 #undef NODE_TYPE_CHILD
 } NodeTypeChild;
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_CHILD(subtype) NodeSubtypeChild_ ## subtype
 	NODE_SUBTYPE_CHILD(NO) = 0,
 #undef NODE_SUBTYPE_CHILD
 } NodeSubtypeChild;
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_CHILD_TYPE(subtype) NodeSubtypeChildTypeScoped_ ## subtype
 	NODE_SUBTYPE_CHILD_TYPE(RETURN_NONE) = 1,
 	NODE_SUBTYPE_CHILD_TYPE(RETURN_TYPE),
@@ -50,7 +50,7 @@ typedef enum: uint64_t {
  * MODULE
 */
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeModule_ ## subtype
 	NODE_SUBTYPE(NO) = 0,
 	NODE_SUBTYPE(INPUT),
@@ -62,7 +62,7 @@ typedef enum: uint64_t {
  * SCOPE
 */
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeScope_ ## subtype
 	NODE_SUBTYPE(NO) = 0,
 	NODE_SUBTYPE(THEN),
@@ -79,7 +79,7 @@ typedef enum: uint64_t {
 
 #define MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_COMMAND 0b11
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_IDENTIFICATION(subtype) NodeSubtypeIdentificationBitCommand_ ## subtype
 	NODE_SUBTYPE_IDENTIFICATION(HASH) = 0b00,
 	NODE_SUBTYPE_IDENTIFICATION(AT) = 0b01,
@@ -90,7 +90,7 @@ typedef enum: uint64_t {
 #define SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE 2
 #define MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE (0b1 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE)
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_IDENTIFICATION(subtype) NodeSubtypeIdentificationBitType_ ## subtype
 	NODE_SUBTYPE_IDENTIFICATION(DECLARATION) = 0b0 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE,
 	NODE_SUBTYPE_IDENTIFICATION(INITIALIZATION) = 0b1 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE,
@@ -100,7 +100,7 @@ typedef enum: uint64_t {
 #define SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED 3
 #define MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED (0b11 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED)
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_IDENTIFICATION(subtype) NodeSubtypeIdentificationBitScoped_ ## subtype
 	NODE_SUBTYPE_IDENTIFICATION(NO) = 0b00 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED, // starts at 1 to simplify parsing
 	NODE_SUBTYPE_IDENTIFICATION(LABEL) = 0b01 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED,
@@ -108,13 +108,25 @@ typedef enum: uint64_t {
 #undef NODE_SUBTYPE_IDENTIFICATION
 } NodeSubtypeIdentificationBitScoped;
 
+#define SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER 5
+#define MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER (0b111 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER)
+
+// the known qualifiers on the left, the others are kept in `Parser.qualifiers`
+typedef enum: uint16_t {
+#define NODE_SUBTYPE_IDENTIFICATION(subtype) NodeSubtypeIdentificationBitQualifier_ ## subtype
+	NODE_SUBTYPE_IDENTIFICATION(MUT) = 0b001 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER,
+	NODE_SUBTYPE_IDENTIFICATION(ENTRY) = 0b010 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER,
+	NODE_SUBTYPE_IDENTIFICATION(CUSTOM) = 0b100 << SHIFT_BIT_NODE_SUBTYPE_IDENTIFICATION_QUALIFIER,
+#undef NODE_SUBTYPE_IDENTIFICATION
+} NodeSubtypeIdentificationBitQualifier;
+
 /*
  * CALLS
 */
 
 #define MASK_BIT_NODE_SUBTYPE_CALL_TIME 0b11
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeCallBitTime_ ## subtype
 	NODE_SUBTYPE(BINARY) = 0b00,
 	NODE_SUBTYPE(COMPILE) = 0b01,
@@ -125,7 +137,7 @@ typedef enum: uint64_t {
 #define SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN 2
 #define MASK_BIT_NODE_SUBTYPE_CALL_RETURN (0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN)
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeCallBitReturn_ ## subtype
 	NODE_SUBTYPE(FALSE) = 0b0 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN,
 	NODE_SUBTYPE(TRUE) = 0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN,
@@ -135,14 +147,24 @@ typedef enum: uint64_t {
 #define SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN_DEDUCE 3
 #define MASK_BIT_NODE_SUBTYPE_CALL_RETURN_DEDUCE (0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN_DEDUCE)
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeCallBitReturnDeduce_ ## subtype
 	NODE_SUBTYPE(FALSE) = 0b0 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN_DEDUCE,
 	NODE_SUBTYPE(TRUE) = 0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_RETURN_DEDUCE,
 #undef NODE_SUBTYPE
 } NodeSubtypeCallBitReturnDeduce; // the true case will be used during parsing expressions only
 
-typedef enum: uint64_t {
+#define SHIFT_BIT_NODE_SUBTYPE_CALL_ARGUMENTS 4
+#define MASK_BIT_NODE_SUBTYPE_CALL_ARGUMENTS (0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_ARGUMENTS)
+
+typedef enum: uint16_t {
+#define NODE_SUBTYPE(subtype) NodeSubtypeCallBitArguments_ ## subtype
+	NODE_SUBTYPE(FALSE) = 0b0 << SHIFT_BIT_NODE_SUBTYPE_CALL_ARGUMENTS,
+	NODE_SUBTYPE(TRUE) = 0b1 << SHIFT_BIT_NODE_SUBTYPE_CALL_ARGUMENTS,
+#undef NODE_SUBTYPE
+} NodeSubtypeCallBitArguments; // written with parentheses, the arguments being chained from `child2`
+
+typedef enum: uint8_t {
 #define NODE_TYPE_CHILD(type) NodeTypeChildCall_ ## type
 	NODE_TYPE_CHILD(NO) = 0,
 	NODE_TYPE_CHILD(RETURN_UNKNOWN), // may return a type to be deduced or no return
@@ -155,7 +177,7 @@ typedef enum: uint64_t {
  * MODIFIERS (to be done)
 */
 
-typedef enum: uint64_t {
+typedef enum: uint8_t {
 #define NODE_TYPE_CHILD(type) NodeTypeChildType_ ## type
 	NODE_TYPE_CHILD(NO) = 0,
 	NODE_TYPE_CHILD(MODIFIER),
@@ -163,7 +185,7 @@ typedef enum: uint64_t {
 #undef NODE_TYPE_CHILD
 } NodeTypeChildType;
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE_CHILD_TYPE(subtype) NodeSubtypeChildTypeModifier_ ## subtype
 	NODE_SUBTYPE_CHILD_TYPE(NO) = 0,
 	NODE_SUBTYPE_CHILD_TYPE(AMPERSAND_LEFT),
@@ -183,37 +205,268 @@ typedef enum: uint64_t {
  * LITERAL
 */
 
-typedef enum: uint64_t {
+typedef enum: uint16_t {
 #define NODE_SUBTYPE(subtype) NodeSubtypeLiteral_ ## subtype
 	NODE_SUBTYPE(NO) = 0,
 	NODE_SUBTYPE(NUMBER) = TokenSubtype_LITERAL_NUMBER,
 	NODE_SUBTYPE(CHARACTER) = TokenSubtype_LITERAL_CHARACTER,
 	NODE_SUBTYPE(STRING) = TokenSubtype_LITERAL_STRING,
-#undef NODE_SUBTYPE_LITERAL
+#undef NODE_SUBTYPE
 } NodeSubtypeLiteral;
 
-typedef struct Node Node;
+/*
+ * EXPRESSION
+ * `.token` is the operator, `child1` and `child2` the operands (only `child1` for a prefix operator)
+*/
+
+typedef enum: uint16_t {
+#define NODE_SUBTYPE(subtype) NodeSubtypeExpression_ ## subtype
+	NODE_SUBTYPE(NO) = 0,
+	NODE_SUBTYPE(KEY), // `child1` points to the identification, 0 if not visible
+	NODE_SUBTYPE(ARGUMENT), // `child1` is the value and `child2` the next argument of a call
+	NODE_SUBTYPE(NEGATE),
+	NODE_SUBTYPE(NOT),
+	NODE_SUBTYPE(OR),
+	NODE_SUBTYPE(XOR),
+	NODE_SUBTYPE(AND),
+	NODE_SUBTYPE(ADD),
+	NODE_SUBTYPE(SUBTRACT),
+	NODE_SUBTYPE(MULTIPLY),
+	NODE_SUBTYPE(DIVIDE),
+	NODE_SUBTYPE(MODULO),
+#undef NODE_SUBTYPE
+} NodeSubtypeExpression;
 
-struct Node {
+/*
+ * the nodes are stored in `Parser.nodes` and refer to each other by index, 0 is the null node
+ * a node takes 16 bytes, so 4 nodes fit in a cache line
+*/
+
+typedef struct {
+	uint8_t type;
 	bool is_child;
-	uint64_t type;
-	uint64_t subtype;
+	uint16_t subtype;
 	union {
-		uint64_t value;
-		void* value_ptr;
-		void (*value_fn)();
-		const Token* token;};
+		uint32_t value;
+		uint32_t token;}; // index in `Lexer.tokens` (0 if none)
 	union {
-		Node* child;
+		uint32_t child;
 		struct {
-			Node* child1;
-			Node* child2;};};
-};
+			uint32_t child1;
+			uint32_t child2;};};
+} Node;
+
+static_assert(sizeof(Node) == 16);
+
+// the instruction starting at a token, known before creating any node (see `parser_lookahead`)
+typedef enum: uint8_t {
+#define PARSER_CONSTRUCT(type) ParserConstruct_ ## type
+	PARSER_CONSTRUCT(NO) = 0,
+	PARSER_CONSTRUCT(MODULE),
+	PARSER_CONSTRUCT(SCOPE),
+	PARSER_CONSTRUCT(IDENTIFICATION),
+	PARSER_CONSTRUCT(CALL),
+#undef PARSER_CONSTRUCT
+} ParserConstruct;
+
+// a scope waiting for its period
+typedef struct {
+	uint32_t node; // SCOPE_START
+	size_t count_symbols; // in `ParserSymbolTable.symbols` before the scope
+} ParserScope;
+
+// a parenthesis open in the type being parsed
+typedef struct {
+	bool is_filled; // by a parameter or a type, else the label has no parameter
+} ParserTypeNest;
+
+typedef enum: uint8_t {
+#define PARSER_EXPRESSION_OPERATOR_TYPE(type) ParserExpressionOperatorType_ ## type
+	PARSER_EXPRESSION_OPERATOR_TYPE(BINARY),
+	PARSER_EXPRESSION_OPERATOR_TYPE(PREFIX),
+	PARSER_EXPRESSION_OPERATOR_TYPE(PARENTHESIS),
+	PARSER_EXPRESSION_OPERATOR_TYPE(CALL),
+#undef PARSER_EXPRESSION_OPERATOR_TYPE
+} ParserExpressionOperatorType;
+
+// an operator of the expression being parsed, waiting for its right operand
+typedef struct {
+	ParserExpressionOperatorType type;
+	uint8_t power; // binding power, 0 for the parentheses
+	uint16_t subtype;
+	uint32_t token;
+	uint32_t argument_first; // of a call
+	uint32_t argument_last;
+	size_t count_operands; // below the parenthesis
+} ParserExpressionOperator;
+
+// a name which may be declared later in the file, resolved at the end of `create_parser`
+typedef struct {
+	uint32_t node; // `child1` is set to the identification
+	uint32_t token;
+} ParserFixup;
+
+// an instruction at file scope, the boundary of an incremental parse (see "parser_incremental.h")
+typedef struct {
+	uint32_t token; // first token
+	uint32_t node; // first node, its nodes end at the first node of the next one
+} ParserTop;
+
+// the tokens from `start` to `end_old` of the previous lexing replaced by the tokens from `start` to `end_new`
+typedef struct {
+	size_t start;
+	size_t end_old;
+	size_t end_new;
+} ParserEdit;
+
+/*
+ * symbol table of the names visible while parsing (see "parser_symbol.h")
+ * - `symbols` is a stack in order of identification, popped at the end of a scope
+ * - `table` is an open addressing table from an interned name to its innermost symbol,
+ *   a slot is kept when its name goes out of scope so nothing is ever deleted
+*/
+
+typedef struct {
+	uint32_t node; // identification or parameter
+	uint32_t name; // ID in `Lexer.interner`
+	uint32_t shadowed; // index + 1 of the symbol with the same name in an outer scope (0 if none)
+} ParserSymbol;
+
+typedef struct {
+	uint32_t name; // 0 if the slot is empty
+	uint32_t symbol; // index + 1 of the innermost symbol of the name (0 if out of scope)
+} ParserSymbolSlot;
+
+typedef struct {
+	MemoryArea symbols;
+	size_t count_symbols;
+	MemoryArea table; // the count is a power of 2
+	size_t count_table; // used slots
+} ParserSymbolTable;
+
+/*
+ * table of the types (see "parser_type_table.h"), structurally identical types share the nodes of one chain
+ * the index of the first node of the chain is the ID of the type, so two types are equal if their IDs are
+ * the part of a chain holding the type of a parameter is interned apart, with the node ending it
+*/
+
+typedef struct {
+	uint32_t hash;
+	uint32_t node; // 0 if the slot is empty
+	uint32_t end; // excluded, 0 for a whole chain
+} ParserTypeSlot;
+
+typedef struct {
+	MemoryArea table; // the count is a power of 2
+	size_t count_table; // used slots
+} ParserTypeTable;
+
+/*
+ * the qualifiers without a bit (see "parser_qualifier.h"), in the order of their identifications
+*/
+
+typedef struct {
+	uint32_t node; // identification
+	uint32_t token; // QL or QR word, named on its side
+} ParserQualifier;
+
+typedef struct {
+	MemoryArea qualifiers;
+	size_t count_qualifiers;
+} ParserQualifierTable;
+
+/*
+ * table of the signatures of the parameterized labels (see "parser_signature.h"), read in place of their type chains
+ * the types are IDs in `Parser.types` of their part of the chain of the label, equal for equal types
+*/
+
+typedef struct {
+	uint32_t node; // identification of the label
+	uint32_t type_return; // 0 if none
+	uint32_t parameters; // index of the type of the first parameter in `ParserSignatureTable.parameters`
+	uint16_t count_parameters;
+	uint8_t command; // calling convention, `NodeSubtypeIdentificationBitCommand`
+} ParserSignature;
+
+typedef struct {
+	uint32_t node; // 0 if the slot is empty
+	uint32_t signature; // index in `ParserSignatureTable.signatures`
+} ParserSignatureSlot;
+
+typedef struct {
+	MemoryArea signatures;
+	size_t count_signatures;
+	MemoryArea parameters;
+	size_t count_parameters;
+	MemoryArea table; // from the identification to its signature, the count is a power of 2
+} ParserSignatureTable;
+
+/*
+ * the finished AST flattened in pre-order (see "parser_linear.h"), a node is followed by its subtree
+ * - the instructions of a scope are the children of its start, its end being the last one
+ * - a link of a chain (types, submodules, arguments) is the parent of the next link
+ * - the keys and the calls do not hold what they point to, a shared type is repeated
+*/
+
+typedef struct {
+	Node node; // copy of the node, the children still being indexes in `Parser.nodes`
+	uint32_t id; // index in `Parser.nodes`
+	uint32_t size; // entries of the subtree, itself included, the next sibling is `size` entries further
+} ParserLinearNode;
+
+typedef struct {
+	MemoryArea nodes;
+	size_t count_nodes;
+} ParserLinear;
+
+// returned by a callback of `ParserVisitor` before the subtree of its node
+typedef enum: uint8_t {
+#define PARSER_VISIT(type) ParserVisit_ ## type
+	PARSER_VISIT(CONTINUE) = 0,
+	PARSER_VISIT(SKIP), // neither the subtree nor the post callback of the node
+	PARSER_VISIT(STOP),
+#undef PARSER_VISIT
+} ParserVisit;
+
+typedef ParserVisit (*ParserVisitCallback)(
+	const ParserLinearNode* entry,
+	size_t depth,
+	void* data);
+
+#define COUNT_NODE_TYPE (NodeType_EXPRESSION + 1)
+
+/*
+ * the callbacks of a walk over `ParserLinear`, null if none
+ * the links of the chains (`Node.is_child`) have their own types, so their own callbacks
+*/
+
+typedef struct {
+	ParserVisitCallback pre[COUNT_NODE_TYPE];
+	ParserVisitCallback post[COUNT_NODE_TYPE]; // the return value is ignored but `STOP`
+	ParserVisitCallback pre_link;
+	ParserVisitCallback post_link;
+} ParserVisitor;
 
 typedef struct {
 	const Lexer* lexer;
-	MemoryChain nodes;
-	MemoryChain declarations; // declarations at file scope
+	MemoryArea nodes;
+	size_t count_nodes;
+	ParserSymbolTable symbols; // at the end of the file, only the file scope is left
+	ParserTypeTable types;
+	ParserSignatureTable signatures;
+	ParserQualifierTable qualifiers;
+	MemoryArea fixups;
+	size_t count_fixups;
+	MemoryArea scopes; // stack of the open scopes
+	size_t count_scopes;
+	MemoryArea nests; // stack of the parentheses of the type being parsed
+	size_t count_nests;
+	MemoryArea operators; // stacks of the expression being parsed, of `ParserExpressionOperator`
+	MemoryArea operands; // of nodes
+	MemoryArea tops; // the instructions at file scope in order
+	size_t count_tops;
+	void* cache_addr; // `nodes` points in a mapped AST file if not null
+	size_t cache_length;
 } Parser;
 
 #endif
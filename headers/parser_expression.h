@@ -0,0 +1,11 @@
+#ifndef PARSER_EXPRESSION
+#define PARSER_EXPRESSION
+
+#include "parser_def.h"
+
+int if_expression_create_nodes(
+	size_t* i,
+	uint32_t* node_expression,
+	Parser* parser);
+
+#endif
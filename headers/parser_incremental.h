@@ -0,0 +1,12 @@
+#ifndef PARSER_INCREMENTAL
+#define PARSER_INCREMENTAL
+
+#include "parser_def.h"
+
+int parser_incremental_create(
+	const Parser* previous,
+	const ParserEdit* edits,
+	size_t count_edits,
+	Parser* parser);
+
+#endif
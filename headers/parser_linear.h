@@ -0,0 +1,12 @@
+#ifndef PARSER_LINEAR
+#define PARSER_LINEAR
+
+#include "parser_def.h"
+
+void parser_initialize_linear(ParserLinear* linear);
+bool parser_create_linear(
+	const Parser* parser,
+	ParserLinear* linear);
+void parser_destroy_linear(ParserLinear* linear);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef PARSER_PARALLEL
+#define PARSER_PARALLEL
+
+#include "parser_def.h"
+
+int parser_parallel_create(Parser* parser);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PARSER_QUALIFIER
+#define PARSER_QUALIFIER
+
+#include "parser_def.h"
+
+void parser_initialize_qualifiers(ParserQualifierTable* qualifiers);
+bool parser_create_qualifiers(ParserQualifierTable* qualifiers);
+void parser_destroy_qualifiers(ParserQualifierTable* qualifiers);
+bool parser_qualifier_add(
+	uint32_t node,
+	Parser* parser);
+const ParserQualifier* parser_qualifier_find(
+	uint32_t node,
+	const Parser* parser,
+	size_t* count);
+bool parser_qualifier_merge(
+	const Parser* unit,
+	const uint32_t* map,
+	Parser* parser);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef PARSER_SIGNATURE
+#define PARSER_SIGNATURE
+
+#include "parser_def.h"
+
+void parser_initialize_signatures(ParserSignatureTable* signatures);
+bool parser_create_signatures(ParserSignatureTable* signatures);
+void parser_destroy_signatures(ParserSignatureTable* signatures);
+bool parser_signature_add(
+	uint32_t node,
+	Parser* parser);
+const ParserSignature* parser_signature_find(
+	uint32_t node,
+	const Parser* parser);
+bool parser_signature_merge(
+	const Parser* unit,
+	const uint32_t* map,
+	Parser* parser);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef PARSER_SYMBOL
+#define PARSER_SYMBOL
+
+#include "parser_def.h"
+
+void parser_initialize_symbols(ParserSymbolTable* symbols);
+bool parser_create_symbols(ParserSymbolTable* symbols);
+void parser_destroy_symbols(ParserSymbolTable* symbols);
+uint32_t parser_symbol_name(
+	const Lexer* lexer,
+	const Token* token);
+bool parser_symbol_add(
+	uint32_t name,
+	uint32_t node,
+	ParserSymbolTable* symbols);
+uint32_t parser_symbol_find(
+	uint32_t name,
+	const ParserSymbolTable* symbols);
+void parser_symbol_pop(
+	size_t count_symbols,
+	ParserSymbolTable* symbols);
+
+#endif
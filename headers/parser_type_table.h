@@ -0,0 +1,20 @@
+#ifndef PARSER_TYPE_TABLE
+#define PARSER_TYPE_TABLE
+
+#include "parser_def.h"
+
+void parser_initialize_types(ParserTypeTable* types);
+bool parser_create_types(ParserTypeTable* types);
+void parser_destroy_types(ParserTypeTable* types);
+uint32_t parser_type_intern(
+	uint32_t node,
+	Parser* parser);
+uint32_t parser_type_find(
+	uint32_t node,
+	const Parser* parser);
+uint32_t parser_type_intern_part(
+	uint32_t node,
+	uint32_t end,
+	Parser* parser);
+
+#endif
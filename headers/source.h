@@ -1,10 +1,23 @@
 #ifndef SOURCE_H
 #define SOURCE_H
 
+#include <stddef.h>
+
+/*
+ * `content` begins with a null character, the source is followed by a null character
+ * and at least `SOURCE_PADDING` null characters, so that 64 bytes may be read at once
+ * from anywhere in the source
+ * a big source is mapped instead of read (see `create_source`)
+*/
+
+#define SOURCE_PADDING 64
+
 typedef struct {
 	const char* path;
 	char* content;
 	long int length;
+	void* mapping; // NULL if `content` is allocated on the heap
+	size_t length_mapping;
 } Source;
 
 void initialize_source(Source* source);
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include "debug.h"
 #include "kel.h"
+#include "lexer_profile.h"
 
 int main(
 int argc,
@@ -16,11 +17,13 @@ char** argv) {
 	Source source;
 	MemoryArea memArea;
 	Binary binary;
+	Interner interner;
 	Lexer lexer;
 	Parser parser;
 	initialize_source(&source);
 	initialize_memory_area(&memArea);
 	initialize_binary(&binary);
+	initialize_interner(&interner);
 	initialize_lexer(&lexer);
 	initialize_parser(&parser);
 
@@ -48,24 +51,36 @@ char** argv) {
 	== false)
 		goto END;
 
+	// shared by the sources, so grown rather than sized after one of them
+	if((exit_status = create_interner(
+		CAPACITY_INTERNER,
+		&interner))
+	== false)
+		goto END;
+
 	if((exit_status = create_lexer(
 		&source,
+		&interner,
 		&memArea,
 		&lexer)
 	== false))
 		goto END;
+#ifdef LEXER_PROFILE
+	lexer_profile_print(stderr);
+#endif
 #ifndef NDEBUG
 	debug_print_tokens(&lexer);
+	debug_print_strings(&lexer);
 #endif
 	if((exit_status = create_parser(
 		&lexer,
-		&memArea,
 		&parser))
 	== false)
 		goto END;
 #ifndef NDEBUG
 	debug_print_declarations(&parser);
 	debug_print_nodes(&parser);
+	debug_print_tree(&parser);
 #endif
 	binary_x64(
 		&binary,
@@ -73,6 +88,7 @@ char** argv) {
 END:
 	destroy_parser(&parser);
 	destroy_lexer(&lexer);
+	destroy_interner(&interner);
 	destroy_binary(&binary);
 	destroy_memory_area(&memArea);
 	destroy_source(&source);
@@ -0,0 +1,430 @@
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <string.h>
+#include "interner.h"
+
+#define CHUNK_ARENA 4096
+
+void initialize_interner(Interner* interner) {
+	assert(interner != NULL);
+
+	atomic_init(
+		&interner->table,
+		NULL);
+
+	for(size_t i = 0;
+	i < COUNT_INTERNER_BLOCK;
+	i += 1) interner->blocks[i] = NULL;
+
+	interner->count_blocks = 0;
+	interner->shift_block = 0;
+	interner->capacity = 0;
+	atomic_init(
+		&interner->count,
+		0);
+
+	for(size_t i = 0;
+	i < COUNT_INTERNER_STRIPE;
+	i += 1) {
+		initialize_memory_chain(&interner->stripes[i].arena);
+		interner->stripes[i].count_arena = 0;
+	}
+}
+
+static InternerTable* table_create(
+size_t count,
+InternerTable* previous) {
+	// calloc so every slot is empty
+	InternerTable* const table = calloc(
+		1,
+		sizeof(InternerTable) + count * sizeof(_Atomic uint32_t));
+
+	if(table == NULL)
+		return NULL;
+
+	table->previous = previous;
+	table->count = count;
+	return table;
+}
+
+static void table_destroy(InternerTable* table) {
+	while(table != NULL) {
+		InternerTable* const previous = table->previous;
+		free(table);
+		table = previous;
+	}
+}
+
+bool create_interner(
+size_t capacity,
+Interner* interner) {
+	assert(capacity != 0);
+	assert(interner != NULL);
+	assert(capacity < UINT32_MAX);
+
+	size_t shift_block = 5;
+	// the entry 0 is not a string
+	while(((size_t) 1 << shift_block) < capacity + 1) shift_block += 1;
+
+	InternerTable* const table = table_create(
+		(size_t) 2 << shift_block,
+		NULL);
+	InternerEntry* const entries = malloc(((size_t) 1 << shift_block) * sizeof(InternerEntry));
+
+	if(table == NULL
+	|| entries == NULL) {
+		table_destroy(table);
+		free(entries);
+		return false;
+	}
+
+	atomic_init(
+		&interner->table,
+		table);
+	interner->blocks[0] = entries;
+	interner->count_blocks = 1;
+	interner->shift_block = shift_block;
+	interner->capacity = (size_t) 1 << shift_block;
+	// the entry 0 is the empty string
+	entries[0] = (InternerEntry) {
+		.string = "",
+		.length = 0,
+		.hash = 0};
+	atomic_init(
+		&interner->count,
+		1);
+
+	for(size_t i = 0;
+	i < COUNT_INTERNER_STRIPE;
+	i += 1) {
+		InternerStripe* const stripe = interner->stripes + i;
+
+		if(pthread_mutex_init(
+			&stripe->lock,
+			NULL)
+		!= 0
+		|| create_memory_chain(
+			CHUNK_ARENA,
+			sizeof(char),
+			&stripe->arena)
+		== false) {
+			// the stripes before are destroyed too
+			for(size_t j = 0;
+			j < i;
+			j += 1) {
+				pthread_mutex_destroy(&interner->stripes[j].lock);
+				destroy_memory_chain(&interner->stripes[j].arena);
+			}
+
+			table_destroy(table);
+			free(entries);
+			initialize_interner(interner);
+			return false;
+		}
+
+		stripe->count_arena = 0;
+	}
+
+	return true;
+}
+
+// the block after the first one holds as many entries as the first one, the next ones double
+static InternerEntry* interner_entry(
+uint32_t id,
+const Interner* interner) {
+	const size_t high = id >> interner->shift_block;
+
+	if(high == 0)
+		return interner->blocks[0] + id;
+
+	const size_t block = 64 - (size_t) __builtin_clzll(high);
+	return interner->blocks[block] + (id - ((size_t) 1 << (interner->shift_block + block - 1)));
+}
+
+static uint32_t table_find(
+const char* string,
+size_t length,
+uint64_t hash,
+const InternerTable* table,
+const Interner* interner) {
+	const size_t mask = table->count - 1;
+	size_t i = hash & mask;
+	uint32_t id;
+	// the entry is written before its ID is stored
+	while((id = atomic_load_explicit(
+		table->slots + i,
+		memory_order_acquire))
+	!= 0) {
+		const InternerEntry* entry = interner_entry(
+			id,
+			interner);
+
+		if(entry->hash == hash
+		&& entry->length == length
+		&& memcmp(
+			entry->string,
+			string,
+			length)
+		== 0)
+			return id;
+
+		i = (i + 1) & mask;
+	}
+
+	return 0;
+}
+
+uint32_t interner_find(
+const char* string,
+size_t length,
+uint64_t hash,
+const Interner* interner) {
+	assert(string != NULL);
+	assert(interner != NULL);
+
+	// a table replaced meanwhile misses the latest strings only, found again under the lock
+	return table_find(
+		string,
+		length,
+		hash,
+		atomic_load_explicit(
+			&interner->table,
+			memory_order_acquire),
+		interner);
+}
+
+static char* stripe_copy(
+const char* string,
+size_t length,
+InternerStripe* stripe) {
+	MemoryArea* memArea = &stripe->arena.last->memArea;
+
+	if(stripe->count_arena + length + 1 > memArea->count) {
+		if(memory_chain_add_area(
+			length + 1 > CHUNK_ARENA ? length + 1 : CHUNK_ARENA,
+			&stripe->arena)
+		== false)
+			return NULL;
+
+		memArea = &stripe->arena.last->memArea;
+		stripe->count_arena = 0;
+	}
+
+	char* const copy = (char*) memArea->addr + stripe->count_arena;
+	memcpy(
+		copy,
+		string,
+		length);
+	copy[length] = '\0';
+	stripe->count_arena += length + 1;
+	return copy;
+}
+static void table_insert(
+uint32_t id,
+uint64_t hash,
+InternerTable* table) {
+	const size_t mask = table->count - 1;
+	size_t i = hash & mask;
+	uint32_t empty = 0;
+	// a slot taken meanwhile holds another string
+	while(!atomic_compare_exchange_weak_explicit(
+		table->slots + i,
+		&empty,
+		id,
+		memory_order_release,
+		memory_order_relaxed)) {
+		if(empty != 0)
+			i = (i + 1) & mask;
+
+		empty = 0;
+	}
+}
+// the next ID, 0 if the capacity is reached
+static uint32_t interner_claim(Interner* interner) {
+	uint_least32_t id = atomic_load_explicit(
+		&interner->count,
+		memory_order_relaxed);
+
+	do {
+		if(id >= interner->capacity)
+			return 0;
+	} while(!atomic_compare_exchange_weak_explicit(
+		&interner->count,
+		&id,
+		id + 1,
+		memory_order_relaxed,
+		memory_order_relaxed));
+
+	return (uint32_t) id;
+}
+// a new block of entries and a table twice as large, every stripe being locked
+static bool interner_double(Interner* interner) {
+	if(interner->capacity > UINT32_MAX / 2)
+		return false;
+
+	assert(interner->count_blocks < COUNT_INTERNER_BLOCK);
+
+	InternerTable* const previous = atomic_load_explicit(
+		&interner->table,
+		memory_order_relaxed);
+	InternerTable* const table = table_create(
+		previous->count * 2,
+		previous);
+	InternerEntry* const entries = malloc(interner->capacity * sizeof(InternerEntry));
+
+	if(table == NULL
+	|| entries == NULL) {
+		free(table);
+		free(entries);
+		return false;
+	}
+
+	const uint32_t count = (uint32_t) atomic_load_explicit(
+		&interner->count,
+		memory_order_relaxed);
+
+	for(uint32_t id = 1;
+	id < count;
+	id += 1) table_insert(
+		id,
+		interner_entry(
+			id,
+			interner)->hash,
+		table);
+
+	interner->blocks[interner->count_blocks] = entries;
+	interner->count_blocks += 1;
+	interner->capacity *= 2;
+	atomic_store_explicit(
+		&interner->table,
+		table,
+		memory_order_release);
+	return true;
+}
+// false if the interner cannot grow, true if it is grown from `capacity` (by another thread meanwhile or not)
+static bool interner_grow(
+size_t capacity,
+Interner* interner) {
+	for(size_t i = 0;
+	i < COUNT_INTERNER_STRIPE;
+	i += 1) pthread_mutex_lock(&interner->stripes[i].lock);
+
+	const bool status = interner->capacity != capacity
+	                 || interner_double(interner);
+
+	for(size_t i = COUNT_INTERNER_STRIPE;
+	i > 0;
+	i -= 1) pthread_mutex_unlock(&interner->stripes[i - 1].lock);
+
+	return status;
+}
+// return 0 if the interner is full
+uint32_t interner_intern(
+const char* string,
+size_t length,
+uint64_t hash,
+Interner* interner) {
+	assert(string != NULL);
+	assert(interner != NULL);
+
+	uint32_t id = interner_find(
+		string,
+		length,
+		hash,
+		interner);
+
+	if(id != 0)
+		return id;
+	// the highest bits because the lowest ones index the table
+	InternerStripe* const stripe = interner->stripes + (hash >> 60) % COUNT_INTERNER_STRIPE;
+	pthread_mutex_lock(&stripe->lock);
+
+	while(true) {
+		// inserted by another thread meanwhile, the table cannot be replaced while the stripe is locked
+		id = interner_find(
+			string,
+			length,
+			hash,
+			interner);
+
+		if(id != 0)
+			break;
+
+		const char* copy = stripe_copy(
+			string,
+			length,
+			stripe);
+
+		if(copy == NULL)
+			break;
+
+		id = interner_claim(interner);
+
+		if(id != 0) {
+			InternerEntry* const entry = interner_entry(
+				id,
+				interner);
+			*entry = (InternerEntry) {
+				.string = copy,
+				.length = length,
+				.hash = hash};
+			table_insert(
+				id,
+				hash,
+				atomic_load_explicit(
+					&interner->table,
+					memory_order_relaxed));
+			break;
+		}
+		// the copy is given back while the interner grows
+		stripe->count_arena -= length + 1;
+		const size_t capacity = interner->capacity;
+		pthread_mutex_unlock(&stripe->lock);
+		const bool is_grown = interner_grow(
+			capacity,
+			interner);
+		pthread_mutex_lock(&stripe->lock);
+
+		if(!is_grown)
+			break;
+	}
+
+	pthread_mutex_unlock(&stripe->lock);
+	return id;
+}
+
+const InternerEntry* interner_get(
+uint32_t id,
+const Interner* interner) {
+	assert(interner != NULL);
+	assert(id < atomic_load_explicit(&interner->count, memory_order_relaxed));
+
+	return interner_entry(
+		id,
+		interner);
+}
+
+void destroy_interner(Interner* interner) {
+	if(interner == NULL
+	|| interner->count_blocks == 0)
+		return;
+
+	for(size_t i = 0;
+	i < COUNT_INTERNER_STRIPE;
+	i += 1) {
+		pthread_mutex_destroy(&interner->stripes[i].lock);
+		destroy_memory_chain(&interner->stripes[i].arena);
+	}
+
+	table_destroy(atomic_load_explicit(
+		&interner->table,
+		memory_order_relaxed));
+
+	for(size_t i = 0;
+	i < interner->count_blocks;
+	i += 1) free(interner->blocks[i]);
+
+	initialize_interner(interner);
+}
+
+#undef CHUNK_ARENA
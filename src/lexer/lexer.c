@@ -3,7 +3,12 @@
 #include <stdio.h>
 #include "lexer.h"
 #include "lexer_allocator.h"
+#include "lexer_cache.h"
 #include "lexer_error.h"
+#include "lexer_index.h"
+#include "lexer_literal.h"
+#include "lexer_profile.h"
+#include "lexer_table.h"
 #include "lexer_utils.h"
 
 /*
@@ -36,8 +41,13 @@
  *
  * Qualifier cases are checked first to detect the brackets, so it is easier to detect
  * names (for instance, the name of an L or a R).
+ *
+ * A rule is tried only if the table generated from "tools/lexer_table.c" allows it for
+ * the first two characters of the word (see "lexer_table.h").
 */
 
+#define CHUNK_TOKEN 4096
+
 // more errors will be supported in "lexer_error.c".
 static int error = 0;
 
@@ -111,7 +121,8 @@ Lexer* lexer) {
 			return -1;
 
 		Token* const tokens = (Token*) lexer->tokens.addr;
-		lexer_get_next_word(
+		lexer_index_get_next_word(
+			&lexer->index,
 			code,
 			start,
 			end);
@@ -141,7 +152,9 @@ Lexer* lexer) {
 	long int buffer_end = *end;
 	size_t buffer_i = *i;
 
-	if(isgraph(code[buffer_start - 1])
+	if(lexer_index_is_graph(
+		&lexer->index,
+		buffer_start - 1)
 	|| code[buffer_start] != '['
 	|| tokens[buffer_i - 1].subtype == TokenType_QR)
 		return 0;
@@ -161,10 +174,14 @@ Lexer* lexer) {
 
 	if(code[buffer_end] == ':'
 	// QR possibility
-	&& !isgraph(code[buffer_end + 1]))
+	&& !lexer_index_is_graph(
+		&lexer->index,
+		buffer_end + 1))
 		buffer_end += 1;
 
-	if(isgraph(code[buffer_end])) // performance?
+	if(lexer_index_is_graph(
+		&lexer->index,
+		buffer_end))
 		return 0;
 
 	*start = buffer_start;
@@ -243,7 +260,9 @@ Lexer* lexer) {
 	
 	if(code[*end] == ':'
 	// R possibility
-	&& !isgraph(code[*end + 1]))
+	&& !lexer_index_is_graph(
+		&lexer->index,
+		*end + 1))
 		*end += 1;
 
 	return true;
@@ -268,7 +287,8 @@ Lexer* lexer) {
 			return -1;
 
 		Token* tokens = (Token*) lexer->tokens.addr;
-		lexer_get_next_word(
+		lexer_index_get_next_word(
+			&lexer->index,
 			code,
 			start,
 			end);
@@ -316,7 +336,9 @@ Lexer* lexer) {
 
 	buffer_end += 1;
 
-	if(isgraph(code[buffer_end])) // performance?
+	if(lexer_index_is_graph(
+		&lexer->index,
+		buffer_end))
 		return 0;
 
 	*start = buffer_start;
@@ -341,7 +363,8 @@ Lexer* lexer) {
 		return false;
 
 	if(!previous_is_operator_modifier) {
-		lexer_get_next_word(
+		lexer_index_get_next_word(
+			&lexer->index,
 			code,
 			&start,
 			&buffer_end);
@@ -394,7 +417,9 @@ Lexer* lexer) {
 	long int buffer_end = *end;
 	size_t buffer_i = *i;
 
-	if(isgraph(code[buffer_start - 1])
+	if(lexer_index_is_graph(
+		&lexer->index,
+		buffer_start - 1)
 	|| code[buffer_start] != '[')
 		return 0;
 
@@ -430,7 +455,9 @@ Lexer* lexer) {
 
 	buffer_end += 1;
 
-	if(isgraph(code[buffer_end])) // performance?
+	if(lexer_index_is_graph(
+		&lexer->index,
+		buffer_end))
 		return 0;
 
 	*start = buffer_start;
@@ -457,7 +484,8 @@ Lexer* lexer) {
 
 	long int R_start = *end + 1;
 	long int R_end = *end + 1;
-	lexer_get_next_word(
+	lexer_index_get_next_word(
+		&lexer->index,
 		code,
 		&R_start,
 		&R_end);
@@ -481,11 +509,13 @@ Lexer* lexer) {
 }
 
 static bool if_literal_create_token(
-const char* code,
 long int start,
 long int* end,
-Token* token) {
+Token* token,
+Lexer* lexer) {
+	const char* code = lexer->source->content;
 	TokenSubtype subtype;
+	size_t literal = 0;
 	long int buffer_end = start + 1;
 
 	if(isdigit(code[start])) {
@@ -517,6 +547,16 @@ Token* token) {
 			set_error(-1);
 			return false;
 		}
+		// a digit may not belong to the base
+		if(lexer_literal_number(
+			start,
+			buffer_end,
+			&literal,
+			lexer)
+		== false) {
+			set_error(-1);
+			return false;
+		}
 
 		subtype = TokenSubtype_LITERAL_NUMBER;
 	} else if(code[start] == '\'') {
@@ -546,12 +586,24 @@ Token* token) {
 	} else {
 		return false;
 	}
+	// escape sequences are decoded once in the string pool
+	if(subtype != TokenSubtype_LITERAL_NUMBER
+	&& lexer_literal_string(
+		start,
+		buffer_end - 1,
+		&literal,
+		lexer)
+	== false) {
+		set_error(-1);
+		return false;
+	}
 
 	*token = (Token) {
 		.type = TokenType_LITERAL,
 		.subtype = subtype,
 		.start = start,
-		.end = buffer_end - (subtype != TokenSubtype_LITERAL_NUMBER ? 1 : 0)};
+		.end = buffer_end - (subtype != TokenSubtype_LITERAL_NUMBER ? 1 : 0),
+		.literal = literal};
 	*end = buffer_end;
 	return true;
 }
@@ -609,329 +661,611 @@ Token* token) {
 	return true;
 }
 
+// pool the names of the tokens from `first` to `last` (excluded)
+static bool create_names(
+size_t first,
+size_t last,
+Lexer* lexer) {
+	const char* code = lexer->source->content;
+	Token* const tokens = (Token*) lexer->tokens.addr;
+
+	for(size_t i = first;
+	i < last;
+	i += 1) {
+		Token* const token = tokens + i;
+		size_t name;
+
+		switch(token->type) {
+		case TokenType_QL:
+		case TokenType_QR:
+		case TokenType_QLR:
+		case TokenType_L:
+		case TokenType_R:
+		case TokenType_LR:
+		case TokenType_PL:
+			break;
+		default:
+			continue;
+		}
+
+		if(token->L_end > token->L_start
+		&& lexer_is_valid_name(
+			code,
+			token->L_start,
+			token->L_end)) {
+			if(lexer_literal_name(
+				token->L_start,
+				token->L_end,
+				&name,
+				lexer)
+			== false)
+				return false;
+
+			token->L_name = (uint32_t) name;
+		}
+
+		if(token->R_end > token->R_start
+		&& lexer_is_valid_name(
+			code,
+			token->R_start,
+			token->R_end)) {
+			if(lexer_literal_name(
+				token->R_start,
+				token->R_end,
+				&name,
+				lexer)
+			== false)
+				return false;
+
+			token->R_name = (uint32_t) name;
+		}
+	}
+
+	return true;
+}
+
 void initialize_lexer(Lexer* lexer) {
 	lexer->source = NULL;
+	lexer->interner = NULL;
+	initialize_memory_area(&lexer->index);
 	initialize_memory_area(&lexer->tokens);
+	initialize_memory_area(&lexer->literals);
+	lexer->count_literals = 0;
+	initialize_memory_area(&lexer->literal_words);
+	lexer->count_literal_words = 0;
+	initialize_memory_area(&lexer->strings);
+	lexer->count_strings = 0;
+	initialize_memory_area(&lexer->string_data);
+	lexer->count_string_data = 0;
+	initialize_memory_area(&lexer->string_table);
+	lexer->cache_addr = NULL;
+	lexer->cache_length = 0;
+	lexer->stream_offset = 0;
+	lexer->stream_first = 0;
+	lexer->stream_lookahead = 0;
+	lexer->stream_end = false;
 }
 
-bool create_lexer(
-const Source* source,
-MemoryArea* restrict memArea,
-Lexer* lexer) {
-	assert(source != NULL);
-	assert(memArea != NULL);
-	assert(lexer != NULL);
-
-	lexer->source = source;
+// scan the next word and create its tokens, return 0 at the end of the source
+static int scan_token(Lexer* lexer) {
+	const char* code = lexer->source->content;
+	long int count_L_parenthesis_nest = lexer->scan.count_L_parenthesis_nest;
+	long int start = lexer->scan.start;
+	long int end = lexer->scan.end;
+	size_t i = lexer->scan.i;
 
-	const char* code = source->content;
-	long int count_L_parenthesis_nest = 0; // to get a good match with R parenthesis
-	long int start = 0;
-	long int end = 1;
-	size_t i = 1;
-	// scan errors
-	if(lexer_scan_errors(
-		source,
-		memArea)
+	if(lexer_index_get_next_word(
+		&lexer->index,
+		code,
+		&start,
+		&end)
 	== false)
-		return false;
-
-	if(!lexer_create_allocator(lexer))
-		goto DESTROY;
+		return 0;
 
-	while(lexer_get_next_word(
+	while(lexer_skip_comment(
 		code,
 		&start,
-		&end)
+		&end));
+
+	if(code[end] == '\0')
+		return 0;
+	// allocation
+	if(lexer_allocator(
+		i + 1,
+		lexer)
+	== false)
+		return -1;
+	// create tokens
+	Token* token = (Token*) lexer->tokens.addr + i;
+	// only the rules which may succeed with the first two characters are tried
+	const uint16_t rules = lexer_get_rules(
+		code[start],
+		code[start + 1]);
+
+	if((rules & LexerRule_COMMAND)
+	&& if_command_create_token(
+		code,
+		start,
+		token)
 	== true) {
-		while(lexer_skip_comment(
-			code,
+		LEXER_PROFILE_RULE(COMMAND);
+	} else if((rules & LexerRule_QL)
+	       && set_error(
+		if_QL_create_token(
 			&start,
-			&end));
-
-		if(code[end] == '\0')
-			break;
-		// allocation
-		if(lexer_allocator(
-			i + 1,
-			lexer)
-		== false)
-			goto DESTROY;
-		// create tokens
-		Token* token = (Token*) lexer->tokens.addr + i;
-
-		if(if_command_create_token(
-			code,
-			start,
-			token)
-		== true) {
-			// OK
-		} else if(set_error(
-			if_QL_create_token(
-				&start,
-				&end,
-				&i,
-				lexer))
-		== 1) {
-			// OK
-		} else if(if_L_create_token(
-			start,
 			&end,
-			i,
-			lexer)
-		== true)  {
-			// OK
-		} else if(set_error(
-			if_QR_create_token(
-				&start,
-				&end,
-				&i,
-				lexer))
-		== 1) {
-			// OK
-		} else if(if_R_create_token(
-			start,
+			&i,
+			lexer))
+	== 1) {
+		LEXER_PROFILE_RULE(QL);
+	} else if((rules & LexerRule_L)
+	       && if_L_create_token(
+		start,
+		&end,
+		i,
+		lexer)
+	== true)  {
+		LEXER_PROFILE_RULE(L);
+	} else if((rules & LexerRule_QR)
+	       && set_error(
+		if_QR_create_token(
+			&start,
 			&end,
-			i,
-			lexer)
-		== true) {
-			long int buffer_end = end;
-			lexer_get_next_word(
-				code,
-				&start,
-				&buffer_end);
-
-			if(lexer_is_operator_modifier(code[start])) {
-				Token* tokens = (Token*) lexer->tokens.addr;
+			&i,
+			lexer))
+	== 1) {
+		LEXER_PROFILE_RULE(QR);
+	} else if((rules & LexerRule_R)
+	       && if_R_create_token(
+		start,
+		&end,
+		i,
+		lexer)
+	== true) {
+		LEXER_PROFILE_RULE(R);
+		long int buffer_end = end;
+		lexer_index_get_next_word(
+			&lexer->index,
+			code,
+			&start,
+			&buffer_end);
 
-				do {					
-					i += 1;
-					tokens[i] = (Token) {
-						.type = TokenType_R,
-						.subtype = lexer_character_to_subtype(code[start]),
-						.L_start = start,
-						.L_end = start,
-						.R_start = start,
-						.R_end = buffer_end};
-					
-					if(lexer_allocator(
-						i + 1,
-						lexer)
-					== false)
-						goto DESTROY;
+		if(lexer_is_operator_modifier(code[start])) {
+			LEXER_PROFILE_RULE(R_MODIFIER);
+			Token* tokens = (Token*) lexer->tokens.addr;
 
-					tokens = (Token*) lexer->tokens.addr;
-					lexer_get_next_word(
-						code,
-						&start,
-						&buffer_end);
-				} while(lexer_is_operator_modifier(code[start])); 
+			do {					
+				i += 1;
+				tokens[i] = (Token) {
+					.type = TokenType_R,
+					.subtype = lexer_character_to_subtype(code[start]),
+					.L_start = start,
+					.L_end = start,
+					.R_start = start,
+					.R_end = buffer_end};
+				
+				if(lexer_allocator(
+					i + 1,
+					lexer)
+				== false)
+					return -1;
+
+				tokens = (Token*) lexer->tokens.addr;
+				lexer_index_get_next_word(
+					&lexer->index,
+					code,
+					&start,
+					&buffer_end);
+			} while(lexer_is_operator_modifier(code[start])); 
+
+			end = start;
+		}
+	} else if((rules & LexerRule_QLR)
+	       && set_error(
+		if_QLR_create_token(
+			&start,
+			&end,
+			&i,
+			lexer))
+	== 1) {
+		LEXER_PROFILE_RULE(QLR);
+	} else if((rules & LexerRule_LR)
+	       && if_LR_create_token(
+		start,
+		&end,
+		i,
+		lexer)
+	== true) {
+		LEXER_PROFILE_RULE(LR);
+	} else if((rules & LexerRule_PL)
+	       && if_PL_create_token(
+		code,
+		start,
+		&end,
+		token)
+	== true) {
+		LEXER_PROFILE_RULE(PL);
+	} else if((rules & LexerRule_LITERAL)
+	       && if_literal_create_token(
+		start,
+		&end,
+		token,
+		lexer)
+	== true) {
+		LEXER_PROFILE_RULE(LITERAL);
+	} else if(rules & LexerRule_SPECIAL) {
+		Token* tokens = (Token*) lexer->tokens.addr;
+		long int buffer_end = end;
+		// right case
+		if(code[start] == ':'
+		&& (lexer_is_operator_leveling(code[buffer_end])
+		 || code[buffer_end] == '[')) {
+			LEXER_PROFILE_RULE(SPECIAL_R_MODIFIER);
+			// start at the first leveling operator, or open bracket
+			start += 1;
+			buffer_end += 1;
 
-				end = start;
+			do {
+				tokens[i] = (Token) {
+					.type = TokenType_R,
+					.subtype = lexer_character_to_subtype(code[start]),
+					.L_start = start,
+					.L_end = start,
+					.R_start = start,
+					.R_end = buffer_end};
+				i += 1;
+				// it must not be EOF (KEY_MODIFIER_EOF)
+				lexer_index_get_next_word(
+					&lexer->index,
+					code,
+					&start,
+					&buffer_end);
+
+				if(lexer_allocator(
+					i + 1,
+					lexer)
+				== false)
+					return -1;
+
+				tokens = (Token*) lexer->tokens.addr;
+			} while(lexer_is_operator_modifier(code[start]));
+
+			end = start;
+			i -= 1; // `i` is incremented at the end of the loop
+		} else if(code[start] == ':'
+		       && code[buffer_end] == '(') {
+			LEXER_PROFILE_RULE(SPECIAL_R_PARENTHESIS);
+			// it is the only special symbol in this case
+			tokens[i] = (Token) {
+				.type = TokenType_R,
+				.subtype = TokenSubtype_LPARENTHESIS,
+				.L_start = start,
+				.L_end = start,
+				.R_start = start + 1,
+				.R_end = start + 2};
+			end += 1;
+		} else if(code[start] == ':'
+		       && code[buffer_end] == '`') {
+			LEXER_PROFILE_RULE(SPECIAL_R_GRAVE_ACCENT);
+			tokens[i] = (Token) {
+				.type = TokenType_R,
+				.subtype = TokenSubtype_GRAVE_ACCENT,
+				.L_start = start,
+				.L_end = start,
+				.R_start = start + 1,
+				.R_end = start + 2};
+			end += 1;
+		// left case
+		} else if(lexer_is_operator_leveling(code[start])
+		       || code[start] == '[') {
+			long int buffer_start = start;
+
+			while(lexer_is_operator_modifier(code[buffer_end])) {
+				lexer_index_get_next_word(
+					&lexer->index,
+					code,
+					&buffer_start,
+					&buffer_end);
 			}
-		} else if(set_error(
-			if_QLR_create_token(
-				&start,
-				&end,
-				&i,
-				lexer))
-		== 1) {
-			// OK
-		} else if(if_LR_create_token(
-			start,
-			&end,
-			i,
-			lexer)
-		== true) {
-			// OK
-		} else if(if_PL_create_token(
-			code,
-			start,
-			&end,
-			token)
-		== true) {
-			// OK
-		} else if(if_literal_create_token(
-			code,
-			start,
-			&end,
-			token)
-		== true) {
-			// OK
-		} else if(lexer_is_special(code[start])) {
-			Token* tokens = (Token*) lexer->tokens.addr;
-			long int buffer_end = end;
-			// right case
-			if(code[start] == ':'
-			&& (lexer_is_operator_leveling(code[buffer_end])
-			 || code[buffer_end] == '[')) {
-				// start at the first leveling operator, or open bracket
-				start += 1;
-				buffer_end += 1;
+
+			if(code[buffer_end] == ':'
+			&& lexer_is_operator_modifier(code[start])) {
+				LEXER_PROFILE_RULE(SPECIAL_L_MODIFIER);
 
 				do {
 					tokens[i] = (Token) {
-						.type = TokenType_R,
+						.type = TokenType_L,
 						.subtype = lexer_character_to_subtype(code[start]),
 						.L_start = start,
-						.L_end = start,
-						.R_start = start,
-						.R_end = buffer_end};
+						.L_end = end,
+						.R_start = end,
+						.R_end = end};
 					i += 1;
-					// it must not be EOF (KEY_MODIFIER_EOF)
-					lexer_get_next_word(
+					lexer_index_get_next_word(
+						&lexer->index,
 						code,
 						&start,
-						&buffer_end);
+						&end);
 
 					if(lexer_allocator(
 						i + 1,
 						lexer)
 					== false)
-						goto DESTROY;
+						return -1;
 
 					tokens = (Token*) lexer->tokens.addr;
-				} while(lexer_is_operator_modifier(code[start]));
+				} while(code[start] != ':');
 
-				end = start;
+				end -= 1;
 				i -= 1; // `i` is incremented at the end of the loop
-			} else if(code[start] == ':'
-			       && code[buffer_end] == '(') {
-				// it is the only special symbol in this case
-				tokens[i] = (Token) {
-					.type = TokenType_R,
-					.subtype = TokenSubtype_LPARENTHESIS,
-					.L_start = start,
-					.L_end = start,
-					.R_start = start + 1,
-					.R_end = start + 2};
-				end += 1;
-			} else if(code[start] == ':'
-			       && code[buffer_end] == '`') {
-				tokens[i] = (Token) {
-					.type = TokenType_R,
-					.subtype = TokenSubtype_GRAVE_ACCENT,
-					.L_start = start,
-					.L_end = start,
-					.R_start = start + 1,
-					.R_end = start + 2};
-				end += 1;
-			// left case
-			} else if(lexer_is_operator_leveling(code[start])
-			       || code[start] == '[') {
-				long int buffer_start = start;
-
-				while(lexer_is_operator_modifier(code[buffer_end])) {
-					lexer_get_next_word(
-						code,
-						&buffer_start,
-						&buffer_end);
-				}
-
-				if(code[buffer_end] == ':'
-				&& lexer_is_operator_modifier(code[start])) {
-					do {
-						tokens[i] = (Token) {
-							.type = TokenType_L,
-							.subtype = lexer_character_to_subtype(code[start]),
-							.L_start = start,
-							.L_end = end,
-							.R_start = end,
-							.R_end = end};
-						i += 1;
-						lexer_get_next_word(
-							code,
-							&start,
-							&end);
-
-						if(lexer_allocator(
-							i + 1,
-							lexer)
-						== false)
-							goto DESTROY;
-
-						tokens = (Token*) lexer->tokens.addr;
-					} while(code[start] != ':');
-
-					end -= 1;
-					i -= 1; // `i` is incremented at the end of the loop
-				} else
-					goto TOKEN_SPECIAL;
-			} else if(code[start] == ')'
-			       && count_L_parenthesis_nest == 0) {
-				tokens[i] = (Token) {
-					.type = TokenType_R,
-					.subtype = TokenSubtype_RPARENTHESIS,
-					.L_start = start,
-					.L_end = start,
-					.R_start = start,
-					.R_end = start + 1};
-			} else {
+			} else
+				goto TOKEN_SPECIAL;
+		} else if(code[start] == ')'
+		       && count_L_parenthesis_nest == 0) {
+			LEXER_PROFILE_RULE(SPECIAL_RPARENTHESIS);
+			tokens[i] = (Token) {
+				.type = TokenType_R,
+				.subtype = TokenSubtype_RPARENTHESIS,
+				.L_start = start,
+				.L_end = start,
+				.R_start = start,
+				.R_end = start + 1};
+		} else {
 TOKEN_SPECIAL:
-				// to process R parenthesis
-				if(code[start] == '(')
-					count_L_parenthesis_nest += 1;
-				else if(code[start] == ')')
-					count_L_parenthesis_nest -= 1;
-				// to declare a lock
-				if(code[start] == ':') {
-					size_t buffer_start = start + 1;
-
-					while(code[buffer_start] != '\0'
-					   && !isgraph(code[buffer_start])) buffer_start += 1;
-
-					if(!lexer_is_command(code[buffer_start])) {
-						create_token_special(
-							code,
-							start,
-							TokenType_COLON_LONELY,
-							token);
-					} else {
-						goto CREATE_TOKEN_SPECIAL;
-					}
-				} else {
-CREATE_TOKEN_SPECIAL:
+			LEXER_PROFILE_RULE(SPECIAL);
+			// to process R parenthesis
+			if(code[start] == '(')
+				count_L_parenthesis_nest += 1;
+			else if(code[start] == ')')
+				count_L_parenthesis_nest -= 1;
+			// to declare a lock
+			if(code[start] == ':') {
+				long int buffer_start = start + 1;
+
+				lexer_index_skip_blanks(
+					&lexer->index,
+					&buffer_start);
+
+				if(!lexer_is_command(code[buffer_start])) {
 					create_token_special(
 						code,
 						start,
-						TokenType_SPECIAL,
+						TokenType_COLON_LONELY,
 						token);
+				} else {
+					goto CREATE_TOKEN_SPECIAL;
 				}
+			} else {
+CREATE_TOKEN_SPECIAL:
+				create_token_special(
+					code,
+					start,
+					TokenType_SPECIAL,
+					token);
 			}
-		} else if(if_valid_name_create_token(
-			code,
-			start,
-			end,
-			token)
-		== true) {
-			// OK
-		} else
-			goto DESTROY;
+		}
+	} else if((rules & LexerRule_NAME)
+	       && if_valid_name_create_token(
+		code,
+		start,
+		end,
+		token)
+	== true) {
+		LEXER_PROFILE_RULE(NAME);
+	} else
+		return -1;
 
-		if(error == -1)
-			goto DESTROY;
+	if(error == -1)
+		return -1;
 
-		i += 1;
-	}
+	i += 1;
+
+	if(create_names(
+		lexer->scan.i,
+		i,
+		lexer)
+	== false)
+		return -1;
+
+	LEXER_PROFILE_SCAN(
+		lexer,
+		end,
+		i);
+	lexer->scan = (LexerScan) {
+		.start = start,
+		.end = end,
+		.count_L_parenthesis_nest = count_L_parenthesis_nest,
+		.i = i};
+	return 1;
+}
+
+static void initialize_lexer_scan(LexerScan* scan) {
+	*scan = (LexerScan) {
+		.start = 0,
+		.end = 1,
+		.count_L_parenthesis_nest = 0,
+		.i = 1};
+}
+
+bool create_lexer(
+const Source* source,
+Interner* interner,
+MemoryArea* restrict memArea,
+Lexer* lexer) {
+	assert(source != NULL);
+	assert(interner != NULL);
+	assert(memArea != NULL);
+	assert(lexer != NULL);
 
-	if(i == 1)
+	lexer->source = source;
+	lexer->interner = interner;
+	int status;
+	// an unchanged source is not tokenized again
+	if(lexer_cache_load(lexer))
+		return true;
+
+	if(!lexer_create_index(
+		source,
+		&lexer->index))
+		goto DESTROY;
+	// scan errors
+	if(lexer_scan_errors(
+		source,
+		&lexer->index,
+		memArea)
+	== false)
+		goto DESTROY;
+
+	if(!lexer_create_allocator(
+		CHUNK_TOKEN,
+		lexer))
+		goto DESTROY;
+
+	initialize_lexer_scan(&lexer->scan);
+
+	while((status = scan_token(lexer)) == 1);
+
+	if(status == -1
+	|| lexer->scan.i == 1)
 		goto DESTROY;
 
-	lexer->tokens.count = i;
+	lexer->tokens.count = lexer->scan.i;
+	// the index is only needed while tokenizing
+	destroy_memory_area(&lexer->index);
 
 	if(!lexer_allocator_shrink(lexer))
 		goto DESTROY;
+	// not being able to write the token file is not an error
+	lexer_cache_store(lexer);
+	return true;
+DESTROY:
+	destroy_lexer(lexer);
+	return false;
+}
+
+/*
+ * a stream keeps a window of tokens in `Lexer.tokens` instead of the whole file
+ * `Lexer.stream_offset` is the index in the stream of the first token of the area
+ * once the area is half full, the tokens before `Lexer.stream_first` are dropped
+ * (the last token is always kept because the rules look at the previous token)
+*/
+
+bool create_lexer_stream(
+const Source* source,
+Interner* interner,
+MemoryArea* restrict memArea,
+size_t lookahead,
+Lexer* lexer) {
+	assert(source != NULL);
+	assert(interner != NULL);
+	assert(memArea != NULL);
+	assert(lookahead != 0);
+	assert(lexer != NULL);
 
+	lexer->source = source;
+	lexer->interner = interner;
+	// the index is kept until the end of the stream
+	if(!lexer_create_index(
+		source,
+		&lexer->index))
+		goto DESTROY;
+
+	if(lexer_scan_errors(
+		source,
+		&lexer->index,
+		memArea)
+	== false)
+		goto DESTROY;
+	// twice the window so that dropping tokens is amortized
+	if(!lexer_create_allocator(
+		2 * lookahead + 2,
+		lexer))
+		goto DESTROY;
+
+	initialize_lexer_scan(&lexer->scan);
+	lexer->stream_offset = 0;
+	lexer->stream_first = 1;
+	lexer->stream_lookahead = lookahead;
+	lexer->stream_end = false;
 	return true;
 DESTROY:
 	destroy_lexer(lexer);
 	return false;
 }
 
+static void stream_drop_tokens(Lexer* lexer) {
+	Token* const tokens = (Token*) lexer->tokens.addr;
+	size_t count = lexer->stream_first - lexer->stream_offset;
+
+	if(count > lexer->scan.i - 1)
+		count = lexer->scan.i - 1;
+	// not worth it, the area grows instead
+	if(count < lexer->tokens.count / 4)
+		return;
+
+	memmove(
+		tokens,
+		tokens + count,
+		(lexer->scan.i - count) * sizeof(Token));
+	lexer->stream_offset += count;
+	lexer->scan.i -= count;
+}
+// the token stays valid until the next call
+const Token* lexer_stream_get(
+size_t index,
+Lexer* lexer) {
+	assert(lexer != NULL);
+	assert(index >= lexer->stream_first);
+	assert(index < lexer->stream_first + lexer->stream_lookahead);
+
+	while(!lexer->stream_end
+	   && index >= lexer->stream_offset + lexer->scan.i) {
+		if(lexer->scan.i >= lexer->tokens.count / 2)
+			stream_drop_tokens(lexer);
+
+		switch(scan_token(lexer)) {
+		case -1: return NULL;
+		case 0:
+			// the null token ends the stream like the token array
+			if(lexer_allocator(
+				lexer->scan.i + 1,
+				lexer)
+			== false)
+				return NULL;
+
+			((Token*) lexer->tokens.addr)[lexer->scan.i] = (Token) {
+				.type = TokenType_NO,
+				.subtype = TokenSubtype_NO,
+				.start = 0,
+				.end = 0};
+			lexer->stream_end = true;
+			break;
+		case 1: /* fall through */;
+		}
+	}
+
+	if(index >= lexer->stream_offset + lexer->scan.i)
+		index = lexer->stream_offset + lexer->scan.i;
+
+	return (const Token*) lexer->tokens.addr + (index - lexer->stream_offset);
+}
+// the tokens before `index` will not be read anymore
+void lexer_stream_release(
+size_t index,
+Lexer* lexer) {
+	assert(lexer != NULL);
+	assert(index >= lexer->stream_first);
+
+	lexer->stream_first = index;
+}
+
 void destroy_lexer(Lexer* lexer) {
 	if(lexer == NULL)
 		return;
 	
+	destroy_memory_area(&lexer->index);
 	lexer_destroy_allocator(lexer);
 	initialize_lexer(lexer);
 }
+
+#undef CHUNK_TOKEN
@@ -2,8 +2,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "lexer_allocator.h"
+#include "lexer_cache.h"
+#include "lexer_profile.h"
 
 #define CHUNK 4096
+#define CHUNK_LITERAL 64
+#define CHUNK_STRING_DATA 1024
+#define COUNT_STRING_TABLE 64
 
 static void create_token_null(Token* token) {
 	*token = (Token) {
@@ -13,30 +18,132 @@ static void create_token_null(Token* token) {
 		.end = 0};
 }
 
-bool lexer_create_allocator(Lexer* lexer) {
+static bool area_reserve(
+size_t minimum,
+size_t chunk,
+MemoryArea* memArea) {
+	if(memArea->count <= minimum) {
+		const size_t count = (minimum / chunk + 1) * chunk;
+		LEXER_PROFILE_GROWTH(
+			memArea->count,
+			count,
+			memArea->size_type);
+
+		if(memory_area_realloc(
+			count,
+			memArea)
+		== false)
+			return false;
+	}
+
+	return true;
+}
+
+bool lexer_create_allocator(
+size_t count,
+Lexer* lexer) {
 	if(create_memory_area(
-		CHUNK,
+		count,
 		sizeof(Token),
 		&lexer->tokens)
 	== false)
 		return false;
 
 	create_token_null((Token*) lexer->tokens.addr);
+
+	if(create_memory_area(
+		CHUNK_LITERAL,
+		sizeof(Literal),
+		&lexer->literals)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_LITERAL,
+		sizeof(uint64_t),
+		&lexer->literal_words)
+	== false)
+		return false;
+	if(create_memory_area(
+		CHUNK_LITERAL,
+		sizeof(LiteralString),
+		&lexer->strings)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_STRING_DATA,
+		sizeof(char),
+		&lexer->string_data)
+	== false)
+		return false;
+	// calloc so every entry is empty
+	if(create_memory_area(
+		COUNT_STRING_TABLE,
+		sizeof(uint32_t),
+		&lexer->string_table)
+	== false)
+		return false;
+	// the first literals are null like the first token
+	((Literal*) lexer->literals.addr)[0] = (Literal) {
+		.value = 0,
+		.count_words = 0,
+		.base = 0};
+	((LiteralString*) lexer->strings.addr)[0] = (LiteralString) {
+		.start = 0,
+		.length = 0,
+		.hash = 0,
+		.id = 0};
+	lexer->count_literals = 1;
+	lexer->count_literal_words = 0;
+	lexer->count_strings = 1;
+	lexer->count_string_data = 0;
 	return true;
 }
 
 bool lexer_allocator(
 size_t minimum,
 Lexer* lexer) {
-	if(lexer->tokens.count <= minimum) {
-		if(memory_area_realloc(
-			(minimum / CHUNK + 1) * CHUNK,
-			&lexer->tokens)
-		== false)
-			return false;	
-	}
+	return area_reserve(
+		minimum,
+		CHUNK,
+		&lexer->tokens);
+}
 
-	return true;
+bool lexer_allocator_literal(
+size_t minimum,
+Lexer* lexer) {
+	return area_reserve(
+		minimum,
+		CHUNK_LITERAL,
+		&lexer->literals);
+}
+
+bool lexer_allocator_literal_word(
+size_t minimum,
+Lexer* lexer) {
+	return area_reserve(
+		minimum,
+		CHUNK_LITERAL,
+		&lexer->literal_words);
+}
+
+bool lexer_allocator_string(
+size_t minimum,
+Lexer* lexer) {
+	return area_reserve(
+		minimum,
+		CHUNK_LITERAL,
+		&lexer->strings);
+}
+
+bool lexer_allocator_string_data(
+size_t minimum,
+Lexer* lexer) {
+	return area_reserve(
+		minimum,
+		CHUNK_STRING_DATA,
+		&lexer->string_data);
 }
 
 bool lexer_allocator_shrink(Lexer* lexer) {
@@ -48,7 +155,20 @@ bool lexer_allocator_shrink(Lexer* lexer) {
 }
 
 void lexer_destroy_allocator(Lexer* lexer) {
+	if(lexer->cache_addr != NULL) {
+		lexer_cache_unmap(lexer);
+		return;
+	}
+
+	destroy_memory_area(&lexer->string_table);
+	destroy_memory_area(&lexer->string_data);
+	destroy_memory_area(&lexer->strings);
+	destroy_memory_area(&lexer->literal_words);
+	destroy_memory_area(&lexer->literals);
 	destroy_memory_area(&lexer->tokens);
 }
 
+#undef COUNT_STRING_TABLE
+#undef CHUNK_STRING_DATA
+#undef CHUNK_LITERAL
 #undef CHUNK
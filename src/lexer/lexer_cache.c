@@ -0,0 +1,364 @@
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lexer_cache.h"
+#include "lexer_utils.h"
+
+/*
+ * a token file is named after the hash of the source content and is laid out as:
+ * - header
+ * - tokens, literals, literal words, strings, string table (each one aligned on 8 bytes)
+ * - string data
+ * it is mapped as is, the areas of the lexer pointing in the mapping.
+ * the cache is off unless `KEL_CACHE` names the directory of the files.
+*/
+
+#define LEXER_CACHE_ENVIRONMENT "KEL_CACHE"
+#define LEXER_CACHE_MAGIC 0x544C454B // "KELT"
+// to be incremented whenever the layout or the tokenization changes
+#define LEXER_CACHE_VERSION 3
+#define LENGTH_PATH 4096
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t hash;
+	uint64_t length; // of the source
+	uint32_t size_token;
+	uint32_t size_literal;
+	uint32_t size_string;
+	uint32_t size_string_slot; // of `Lexer.string_table`
+	uint64_t count_tokens;
+	uint64_t count_literals;
+	uint64_t count_literal_words;
+	uint64_t count_strings;
+	uint64_t count_string_data;
+	uint64_t count_string_table;
+} LexerCacheHeader;
+
+static size_t align(size_t size) {
+	return (size + 7) & ~(size_t) 7;
+}
+
+static uint64_t source_hash(const Source* source) {
+	return lexer_hash(
+		source->content + 1,
+		(size_t) source->length);
+}
+
+// false if the path does not fit
+static bool cache_path(
+const char* directory,
+uint64_t hash,
+const char* suffix,
+char* path) {
+	const int length = snprintf(
+		path,
+		LENGTH_PATH,
+		"%s/%016" PRIX64 ".ktok%s",
+		directory,
+		hash,
+		suffix);
+	return length > 0
+	    && length < LENGTH_PATH;
+}
+
+// the directory of the token and AST files, NULL if the cache is off
+const char* lexer_cache_directory(void) {
+	const char* directory = getenv(LEXER_CACHE_ENVIRONMENT);
+	return directory != NULL
+	    && directory[0] != '\0'
+	     ? directory
+	     : NULL;
+}
+// size of each area in the order of the file
+static void cache_sizes(
+const LexerCacheHeader* header,
+size_t* sizes) {
+	sizes[0] = align(header->count_tokens * sizeof(Token));
+	sizes[1] = align(header->count_literals * sizeof(Literal));
+	sizes[2] = align(header->count_literal_words * sizeof(uint64_t));
+	sizes[3] = align(header->count_strings * sizeof(LiteralString));
+	sizes[4] = align(header->count_string_table * sizeof(uint32_t));
+	sizes[5] = header->count_string_data;
+}
+
+bool lexer_cache_load(Lexer* lexer) {
+	assert(lexer != NULL);
+	assert(lexer->source != NULL);
+
+	const Source* source = lexer->source;
+	const uint64_t hash = source_hash(source);
+	const char* directory = lexer_cache_directory();
+	char path[LENGTH_PATH];
+
+	if(directory == NULL
+	|| !cache_path(
+		directory,
+		hash,
+		"",
+		path))
+		return false;
+
+	const int file = open(
+		path,
+		O_RDONLY);
+
+	if(file == -1)
+		return false;
+
+	struct stat status;
+
+	if(fstat(
+		file,
+		&status)
+	== -1
+	|| (size_t) status.st_size < sizeof(LexerCacheHeader)) {
+		close(file);
+		return false;
+	}
+
+	char* const addr = mmap(
+		NULL,
+		(size_t) status.st_size,
+		PROT_READ | PROT_WRITE, // copy on write
+		MAP_PRIVATE,
+		file,
+		0);
+	close(file);
+
+	if(addr == MAP_FAILED)
+		return false;
+
+	const LexerCacheHeader* header = (const LexerCacheHeader*) addr;
+	size_t sizes[6];
+	cache_sizes(
+		header,
+		sizes);
+	size_t size = align(sizeof(LexerCacheHeader));
+
+	for(size_t i = 0;
+	i < 6;
+	i += 1) size += sizes[i];
+
+	if(header->magic != LEXER_CACHE_MAGIC
+	|| header->version != LEXER_CACHE_VERSION
+	|| header->hash != hash
+	|| header->length != (uint64_t) source->length
+	|| header->size_token != sizeof(Token)
+	|| header->size_literal != sizeof(Literal)
+	|| header->size_string != sizeof(LiteralString)
+	|| header->size_string_slot != sizeof(uint32_t)
+	|| size != (size_t) status.st_size) {
+		munmap(
+			addr,
+			(size_t) status.st_size);
+		return false;
+	}
+
+	MemoryArea* const areas[6] = {
+		&lexer->tokens,
+		&lexer->literals,
+		&lexer->literal_words,
+		&lexer->strings,
+		&lexer->string_table,
+		&lexer->string_data};
+	const size_t counts[6] = {
+		header->count_tokens,
+		header->count_literals,
+		header->count_literal_words,
+		header->count_strings,
+		header->count_string_table,
+		header->count_string_data};
+	const size_t sizes_type[6] = {
+		sizeof(Token),
+		sizeof(Literal),
+		sizeof(uint64_t),
+		sizeof(LiteralString),
+		sizeof(uint32_t),
+		sizeof(char)};
+	char* area = addr + align(sizeof(LexerCacheHeader));
+
+	for(size_t i = 0;
+	i < 6;
+	i += 1) {
+		*areas[i] = (MemoryArea) {
+			.addr = area,
+			.count = counts[i],
+			.size_type = sizes_type[i]};
+		area += sizes[i];
+	}
+
+	// the IDs of the interner are only valid in the process which stored them
+	LiteralString* const strings = (LiteralString*) lexer->strings.addr;
+	const char* data = (const char*) lexer->string_data.addr;
+
+	for(size_t i = 1;
+	i < header->count_strings;
+	i += 1) {
+		strings[i].id = interner_intern(
+			data + strings[i].start,
+			strings[i].length,
+			strings[i].hash,
+			lexer->interner);
+
+		if(strings[i].id == 0) {
+			munmap(
+				addr,
+				(size_t) status.st_size);
+			return false;
+		}
+	}
+
+	lexer->count_literals = header->count_literals;
+	lexer->count_literal_words = header->count_literal_words;
+	lexer->count_strings = header->count_strings;
+	lexer->count_string_data = header->count_string_data;
+	lexer->cache_addr = addr;
+	lexer->cache_length = (size_t) status.st_size;
+	return true;
+}
+
+static bool write_area(
+const void* addr,
+size_t size,
+FILE* file) {
+	static const char padding[8] = {0};
+
+	if(size != 0
+	&& fwrite(
+		addr,
+		1,
+		size,
+		file)
+	!= size)
+		return false;
+
+	return fwrite(
+		padding,
+		1,
+		align(size) - size,
+		file) == align(size) - size;
+}
+
+bool lexer_cache_store(const Lexer* lexer) {
+	assert(lexer != NULL);
+	assert(lexer->cache_addr == NULL);
+
+	const LexerCacheHeader header = {
+		.magic = LEXER_CACHE_MAGIC,
+		.version = LEXER_CACHE_VERSION,
+		.hash = source_hash(lexer->source),
+		.length = (uint64_t) lexer->source->length,
+		.size_token = sizeof(Token),
+		.size_literal = sizeof(Literal),
+		.size_string = sizeof(LiteralString),
+		.size_string_slot = sizeof(uint32_t),
+		.count_tokens = lexer->tokens.count,
+		.count_literals = lexer->count_literals,
+		.count_literal_words = lexer->count_literal_words,
+		.count_strings = lexer->count_strings,
+		.count_string_data = lexer->count_string_data,
+		.count_string_table = lexer->string_table.count};
+	const char* directory = lexer_cache_directory();
+	char path[LENGTH_PATH];
+	char path_tmp[LENGTH_PATH];
+
+	if(directory == NULL
+	|| !cache_path(
+		directory,
+		header.hash,
+		"",
+		path)
+	|| !cache_path(
+		directory,
+		header.hash,
+		".tmp",
+		path_tmp))
+		return false;
+
+	if(mkdir(
+		directory,
+		0755)
+	== -1
+	&& access(
+		directory,
+		W_OK)
+	== -1)
+		return false;
+
+	FILE* file = fopen(
+		path_tmp,
+		"wb");
+
+	if(file == NULL)
+		return false;
+
+	bool error = !write_area(
+		&header,
+		sizeof(LexerCacheHeader),
+		file)
+	|| !write_area(
+		lexer->tokens.addr,
+		header.count_tokens * sizeof(Token),
+		file)
+	|| !write_area(
+		lexer->literals.addr,
+		header.count_literals * sizeof(Literal),
+		file)
+	|| !write_area(
+		lexer->literal_words.addr,
+		header.count_literal_words * sizeof(uint64_t),
+		file)
+	|| !write_area(
+		lexer->strings.addr,
+		header.count_strings * sizeof(LiteralString),
+		file)
+	|| !write_area(
+		lexer->string_table.addr,
+		header.count_string_table * sizeof(uint32_t),
+		file)
+	|| fwrite(
+		lexer->string_data.addr,
+		1,
+		header.count_string_data,
+		file)
+	!= header.count_string_data;
+
+	if(fclose(file) == EOF)
+		error = true;
+	// a partial file is never visible under the final name
+	if(error
+	|| rename(
+		path_tmp,
+		path)
+	!= 0) {
+		remove(path_tmp);
+		return false;
+	}
+
+	return true;
+}
+
+void lexer_cache_unmap(Lexer* lexer) {
+	assert(lexer != NULL);
+	assert(lexer->cache_addr != NULL);
+
+	munmap(
+		lexer->cache_addr,
+		lexer->cache_length);
+	lexer->cache_addr = NULL;
+	lexer->cache_length = 0;
+}
+
+#undef LENGTH_PATH
+#undef LEXER_CACHE_VERSION
+#undef LEXER_CACHE_MAGIC
+#undef LEXER_CACHE_ENVIRONMENT
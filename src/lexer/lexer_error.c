@@ -1,11 +1,13 @@
 #include <assert.h>
 #include "lexer_error.h"
+#include "lexer_index.h"
 #include "lexer_utils.h"
 
 #include <stdio.h>
 
 bool lexer_scan_errors(
 const Source* source,
+const MemoryArea* index,
 MemoryArea* memArea) {
 	assert(memArea->count >= (size_t) source->length); // at least the size of the source (matching parenthesis)
 
@@ -16,7 +18,8 @@ MemoryArea* memArea) {
 	long int start = 0;
 	long int end = 1;
 	// a source begins with a null character so that checking code[start - 1] is valid	
-	while(lexer_get_next_word(
+	while(lexer_index_get_next_word(
+		index,
 		code,
 		&start,
 		&end)
@@ -25,7 +28,9 @@ MemoryArea* memArea) {
 		const char c = code[start];
 		// LITERAL_ASCII_NO
 		if(c == '\\'
-		&& !isgraph(code[start + 1])) {
+		&& !lexer_index_is_graph(
+			index,
+			start + 1)) {
 			return false;
 		// DELIMITER_MATCH
 		} else if(lexer_is_delimiter_open(c)) {
@@ -44,35 +49,11 @@ MemoryArea* memArea) {
 			count_delimiter_open -= 1;
 		// COLON
 		} else if(c == ':') {
-			// COLON_EOF
-			if(code[start + 1] == '\0')
-				return false;
-			// COLON_RIGHT_COLON
-			if(code[start + 1] == ':')
-				return false;
-			// COLON_VALID_SPECIAL_LEFT
-			if(lexer_is_special(code[start - 1])
-			&& code[start - 1] != '#'
-			&& code[start - 1] != '&'
-			&& code[start - 1] != '(' // parameterized labels
-			&& code[start - 1] != ')'
-			&& code[start - 1] != '+'
-			&& code[start - 1] != '-'
-			&& code[start - 1] != '@'
-			&& code[start - 1] != ']'
-			&& code[start - 1] != '|')
-				return false;
-			// COLON_VALID_SPECIAL_RIGHT
-			if(lexer_is_special(code[start + 1])
-			&& code[start + 1] != '#'
-			&& code[start + 1] != '&'
-			&& code[start + 1] != '('
-			&& code[start + 1] != '+'
-			&& code[start + 1] != '-'
-			&& code[start + 1] != '@'
-			&& code[start + 1] != '['
-			&& code[start + 1] != '`'
-			&& code[start + 1] != '|')
+			// COLON_EOF, COLON_RIGHT_COLON, COLON_VALID_SPECIAL_LEFT and COLON_VALID_SPECIAL_RIGHT
+			// (the neighbors are classified when building the index)
+			if(lexer_index_is_colon_invalid(
+				index,
+				start))
 				return false;
 		// process a comment
 		} else if(!marker_literal_string
@@ -0,0 +1,145 @@
+#include <assert.h>
+#include "lexer_index.h"
+#include "lexer_table.h"
+#include "lexer_utils.h"
+
+#define SIZE_BLOCK 64
+
+// masks of a block before the neighbors are known
+typedef struct {
+	uint64_t graph;
+	uint64_t stop;
+	uint64_t colon;
+	uint64_t invalid_left;
+	uint64_t invalid_right;
+} BlockMasks;
+
+// the padding of the source is read as null characters
+static void scan_block(
+const char* code,
+size_t first,
+BlockMasks* masks) {
+	*masks = (BlockMasks) {0};
+
+	for(size_t i = 0;
+	i < SIZE_BLOCK;
+	i += 1) {
+		const uint8_t c = (uint8_t) code[first + i];
+		const uint64_t bit = (uint64_t) 1 << i;
+		const uint16_t classes = lexer_classes[c];
+
+		if(classes & LexerClass_GRAPH) masks->graph |= bit;
+		if(c == '\0' || (classes & LexerClass_GRAPH)) masks->stop |= bit;
+		if(c == ':') masks->colon |= bit;
+		if(classes & LexerClass_COLON_INVALID_LEFT) masks->invalid_left |= bit;
+		if(classes & LexerClass_COLON_INVALID_RIGHT) masks->invalid_right |= bit;
+	}
+}
+
+bool lexer_create_index(
+const Source* source,
+MemoryArea* index) {
+	assert(source != NULL);
+	assert(index != NULL);
+	// the null characters before and after the source are indexed,
+	// the last block ends in the padding of the source
+	const size_t count = ((size_t) source->length + 2) / SIZE_BLOCK + 1;
+	static_assert(SOURCE_PADDING >= SIZE_BLOCK);
+
+	if(create_memory_area(
+		count,
+		sizeof(LexerIndexBlock),
+		index)
+	== false)
+		return false;
+
+	LexerIndexBlock* const blocks = index->addr;
+	BlockMasks previous = {0};
+	BlockMasks current;
+	BlockMasks next;
+
+	scan_block(
+		source->content,
+		0,
+		&current);
+
+	for(size_t b = 0;
+	b < count;
+	b += 1) {
+		if(b + 1 < count)
+			scan_block(
+				source->content,
+				(b + 1) * SIZE_BLOCK,
+				&next);
+		else
+			next = (BlockMasks) {0};
+		// the neighbors of the first and last characters are in the adjacent blocks
+		const uint64_t left = (current.invalid_left << 1) | (previous.invalid_left >> 63);
+		const uint64_t right = (current.invalid_right >> 1) | (next.invalid_right << 63);
+
+		blocks[b] = (LexerIndexBlock) {
+			.graph = current.graph,
+			.stop = current.stop,
+			.colon_invalid = current.colon & (left | right)};
+		previous = current;
+		current = next;
+	}
+
+	return true;
+}
+
+bool lexer_index_is_graph(
+const MemoryArea* index,
+long int i) {
+	assert(i >= 0);
+	const LexerIndexBlock* const block = (const LexerIndexBlock*) index->addr + i / SIZE_BLOCK;
+	return (block->graph >> (i % SIZE_BLOCK)) & 1;
+}
+
+bool lexer_index_is_colon_invalid(
+const MemoryArea* index,
+long int i) {
+	assert(i >= 0);
+	const LexerIndexBlock* const block = (const LexerIndexBlock*) index->addr + i / SIZE_BLOCK;
+	return (block->colon_invalid >> (i % SIZE_BLOCK)) & 1;
+}
+// the last block always has a stop bit
+void lexer_index_skip_blanks(
+const MemoryArea* index,
+long int* end) {
+	const LexerIndexBlock* const blocks = index->addr;
+	size_t b = (size_t) *end / SIZE_BLOCK;
+	const uint64_t stop = blocks[b].stop >> (*end % SIZE_BLOCK);
+
+	if(stop != 0) {
+		*end += __builtin_ctzll(stop);
+		return;
+	}
+
+	do {
+		b += 1;
+	} while(blocks[b].stop == 0);
+
+	*end = (long int) (b * SIZE_BLOCK) + __builtin_ctzll(blocks[b].stop);
+}
+
+bool lexer_index_get_next_word(
+const MemoryArea* index,
+const char* string,
+long int* restrict start,
+long int* restrict end) {
+	assert(start != NULL);
+	assert(end != NULL);
+	assert(start != end);
+
+	lexer_index_skip_blanks(
+		index,
+		end);
+	*start = *end;
+
+	return lexer_get_next_word_immediate(
+		string,
+		end);
+}
+
+#undef SIZE_BLOCK
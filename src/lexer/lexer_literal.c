@@ -0,0 +1,325 @@
+#include <assert.h>
+#include <ctype.h>
+#include <string.h>
+#include "lexer_allocator.h"
+#include "lexer_literal.h"
+#include "lexer_utils.h"
+
+#define MASK_HALF_WORD 0xFFFFFFFF
+
+static uint32_t digit_to_value(char c) {
+	return isdigit(c) ? (uint32_t) (c - '0') : (uint32_t) (c - 'A' + 10);
+}
+// `word * base + carry` where `base` and `carry` fit in 32 bits
+static uint64_t word_multiply_add(
+uint64_t word,
+uint32_t base,
+uint32_t* carry) {
+	const uint64_t low = (word & MASK_HALF_WORD) * base + *carry;
+	const uint64_t high = (word >> 32) * base + (low >> 32);
+	*carry = (uint32_t) (high >> 32);
+	return (high << 32) | (low & MASK_HALF_WORD);
+}
+
+bool lexer_literal_number(
+long int start,
+long int end,
+size_t* restrict literal,
+Lexer* lexer) {
+	assert(literal != NULL);
+	assert(lexer != NULL);
+
+	const char* code = lexer->source->content;
+	uint32_t base = 10;
+
+	if(code[start] == '0'
+	&& !isdigit(code[start + 1])) {
+		switch(code[start + 1]) {
+		case 'B': base = 2; break;
+		case 'o': base = 8; break;
+		case 'x': base = 16; break;
+		default: assert(false); // checked by `if_literal_create_token`
+		}
+
+		start += 2;
+	}
+	// the value is built in place after the last words
+	const size_t first_word = lexer->count_literal_words;
+	size_t count_words = 1;
+
+	if(lexer_allocator_literal_word(
+		first_word + count_words,
+		lexer)
+	== false)
+		return false;
+
+	((uint64_t*) lexer->literal_words.addr)[first_word] = 0;
+
+	for(long int i = start;
+	i < end;
+	i += 1) {
+		if(code[i] == '`')
+			continue;
+
+		uint32_t carry = digit_to_value(code[i]);
+
+		if(carry >= base)
+			return false;
+
+		uint64_t* words = (uint64_t*) lexer->literal_words.addr + first_word;
+
+		for(size_t j = 0;
+		j < count_words;
+		j += 1) {
+			words[j] = word_multiply_add(
+				words[j],
+				base,
+				&carry);
+		}
+
+		if(carry != 0) {
+			if(lexer_allocator_literal_word(
+				first_word + count_words + 1,
+				lexer)
+			== false)
+				return false;
+
+			((uint64_t*) lexer->literal_words.addr)[first_word + count_words] = carry;
+			count_words += 1;
+		}
+	}
+
+	if(lexer_allocator_literal(
+		lexer->count_literals + 1,
+		lexer)
+	== false)
+		return false;
+
+	Literal* const number = (Literal*) lexer->literals.addr + lexer->count_literals;
+	const uint64_t* words = (const uint64_t*) lexer->literal_words.addr + first_word;
+
+	if(count_words == 1) {
+		*number = (Literal) {
+			.value = words[0],
+			.count_words = 0,
+			.base = base};
+	} else {
+		*number = (Literal) {
+			.value = first_word,
+			.count_words = count_words,
+			.base = base};
+		lexer->count_literal_words += count_words;
+	}
+
+	*literal = lexer->count_literals;
+	lexer->count_literals += 1;
+	return true;
+}
+
+// return the number of characters read after the backslash, 0 if the sequence is unknown
+static int escape_to_character(
+const char* string,
+long int remaining,
+char* c) {
+	switch(string[0]) {
+	case '0': *c = '\0'; return 1;
+	case '\\': *c = '\\'; return 1;
+	case 'n': *c = '\n'; return 1;
+	case 'r': *c = '\r'; return 1;
+	case 't': *c = '\t'; return 1;
+	case 'x':
+		if(remaining < 3
+		|| !isXdigit(string[1])
+		|| !isXdigit(string[2]))
+			return 0;
+
+		*c = (char) (digit_to_value(string[1]) << 4 | digit_to_value(string[2]));
+		return 3;
+	default: return 0;
+	}
+}
+
+static bool string_table_grow(Lexer* lexer) {
+	const size_t count = lexer->string_table.count * 2;
+
+	if(memory_area_realloc(
+		count,
+		&lexer->string_table)
+	== false)
+		return false;
+
+	uint32_t* const table = (uint32_t*) lexer->string_table.addr;
+	const LiteralString* strings = (const LiteralString*) lexer->strings.addr;
+	memset(
+		table,
+		0,
+		count * sizeof(uint32_t));
+
+	for(size_t i = 1;
+	i < lexer->count_strings;
+	i += 1) {
+		size_t j = strings[i].hash & (count - 1);
+
+		while(table[j] != 0) j = (j + 1) & (count - 1);
+
+		table[j] = (uint32_t) i;
+	}
+
+	return true;
+}
+// get the entry of the string, or the empty entry where it should be inserted
+static uint32_t* string_table_find(
+const char* string,
+size_t length,
+uint64_t hash,
+const Lexer* lexer) {
+	uint32_t* const table = (uint32_t*) lexer->string_table.addr;
+	const LiteralString* strings = (const LiteralString*) lexer->strings.addr;
+	const char* data = (const char*) lexer->string_data.addr;
+	const size_t mask = lexer->string_table.count - 1;
+	size_t i = hash & mask;
+
+	while(table[i] != 0) {
+		const LiteralString* entry = strings + table[i];
+
+		if(entry->hash == hash
+		&& entry->length == length
+		&& memcmp(
+			data + entry->start,
+			string,
+			length)
+		== 0)
+			break;
+
+		i = (i + 1) & mask;
+	}
+
+	return table + i;
+}
+
+// the string is at the end of `Lexer.string_data`, kept only if it is new
+static bool string_pool(
+size_t length,
+size_t* restrict literal,
+Lexer* lexer) {
+	const char* string = (const char*) lexer->string_data.addr + lexer->count_string_data;
+	// grow at half load
+	if(lexer->count_strings * 2 >= lexer->string_table.count
+	&& string_table_grow(lexer) == false)
+		return false;
+
+	const uint64_t hash = lexer_hash(
+		string,
+		length);
+	uint32_t* const entry = string_table_find(
+		string,
+		length,
+		hash,
+		lexer);
+
+	if(*entry == 0) {
+		if(lexer_allocator_string(
+			lexer->count_strings + 1,
+			lexer)
+		== false)
+			return false;
+		// only the first occurrence in the source is interned
+		const uint32_t id = interner_intern(
+			string,
+			length,
+			hash,
+			lexer->interner);
+
+		if(id == 0)
+			return false;
+
+		((LiteralString*) lexer->strings.addr)[lexer->count_strings] = (LiteralString) {
+			.start = lexer->count_string_data,
+			.length = length,
+			.hash = hash,
+			.id = id};
+		*entry = (uint32_t) lexer->count_strings;
+		lexer->count_strings += 1;
+		lexer->count_string_data += length + 1;
+	}
+
+	*literal = *entry;
+	return true;
+}
+
+bool lexer_literal_string(
+long int start,
+long int end,
+size_t* restrict literal,
+Lexer* lexer) {
+	assert(literal != NULL);
+	assert(lexer != NULL);
+
+	const char* code = lexer->source->content;
+	// decoding never makes a string longer
+	if(lexer_allocator_string_data(
+		lexer->count_string_data + (end - start) + 1,
+		lexer)
+	== false)
+		return false;
+	// the string is decoded in place after the last one
+	char* const string = (char*) lexer->string_data.addr + lexer->count_string_data;
+	size_t length = 0;
+
+	for(long int i = start;
+	i < end;
+	i += 1) {
+		if(code[i] != '\\') {
+			string[length] = code[i];
+		} else {
+			const int count = escape_to_character(
+				code + i + 1,
+				end - i - 1,
+				string + length);
+
+			if(count == 0)
+				return false;
+
+			i += count;
+		}
+
+		length += 1;
+	}
+
+	string[length] = '\0';
+	return string_pool(
+		length,
+		literal,
+		lexer);
+}
+// a name is pooled as is
+bool lexer_literal_name(
+long int start,
+long int end,
+size_t* restrict literal,
+Lexer* lexer) {
+	assert(start < end);
+	assert(literal != NULL);
+	assert(lexer != NULL);
+
+	const size_t length = (size_t) (end - start);
+
+	if(lexer_allocator_string_data(
+		lexer->count_string_data + length + 1,
+		lexer)
+	== false)
+		return false;
+
+	char* const string = (char*) lexer->string_data.addr + lexer->count_string_data;
+	memcpy(
+		string,
+		lexer->source->content + start,
+		length);
+	string[length] = '\0';
+	return string_pool(
+		length,
+		literal,
+		lexer);
+}
+
+#undef MASK_HALF_WORD
@@ -0,0 +1,177 @@
+#ifdef LEXER_PROFILE
+#include <assert.h>
+#include "lexer_profile.h"
+
+#define COUNT_TYPE 16
+#define COUNT_SUBTYPE 256
+
+typedef struct {
+	LexerProfileRule rule; // of the word being scanned
+	size_t rule_hits[LexerProfileRule_COUNT];
+	size_t rule_bytes[LexerProfileRule_COUNT];
+	size_t types[COUNT_TYPE];
+	size_t subtypes[COUNT_SUBTYPE];
+	size_t growths;
+	size_t growth_bytes;
+} LexerProfile;
+
+static LexerProfile profile = {0};
+
+static const char* const names_rule[LexerProfileRule_COUNT] = {
+	"COMMAND",
+	"QL",
+	"L",
+	"QR",
+	"R",
+	"R_MODIFIER",
+	"QLR",
+	"LR",
+	"PL",
+	"LITERAL",
+	"SPECIAL_R_MODIFIER",
+	"SPECIAL_R_PARENTHESIS",
+	"SPECIAL_R_GRAVE_ACCENT",
+	"SPECIAL_L_MODIFIER",
+	"SPECIAL_RPARENTHESIS",
+	"SPECIAL",
+	"NAME"};
+
+static const char* const names_type[] = {
+	"NO",
+	"COLON_LONELY",
+	"COMMAND",
+	"SPECIAL",
+	"QL",
+	"QR",
+	"QLR",
+	"L",
+	"R",
+	"LR",
+	"PL",
+	"LITERAL"};
+
+static const char* const names_subtype[] = {
+	"NO",
+	"MODULE_INPUT",
+	"MODULE_OUTPUT",
+	"SCOPE",
+	"IDENTIFIER",
+	"LITERAL_NUMBER",
+	"LITERAL_CHARACTER",
+	"LITERAL_STRING",
+	"EXCLAMATION_MARK",
+	"DQUOTES",
+	"HASH",
+	"MODULO",
+	"AMPERSAND",
+	"SQUOTE",
+	"LPARENTHESIS",
+	"RPARENTHESIS",
+	"ASTERISK",
+	"PLUS",
+	"COMMA",
+	"MINUS",
+	"PERIOD",
+	"DIVIDE",
+	"COLON",
+	"SEMICOLON",
+	"LOBRACKET",
+	"EQUAL",
+	"ROBRACKET",
+	"QUESTION_MARK",
+	"AT",
+	"LBRACKET",
+	"RBRACKET",
+	"BACKSLASH",
+	"CARET",
+	"GRAVE_ACCENT",
+	"LCBRACE",
+	"RCBRACE",
+	"PIPE",
+	"TILDE"};
+
+void lexer_profile_rule(LexerProfileRule rule) {
+	assert(rule < LexerProfileRule_COUNT);
+	profile.rule = rule;
+}
+// called once the tokens of a word are created in `lexer->tokens` from `lexer->scan.i` to `i`
+void lexer_profile_scan(
+const Lexer* lexer,
+long int end,
+size_t i) {
+	const Token* tokens = (const Token*) lexer->tokens.addr;
+
+	profile.rule_hits[profile.rule] += 1;
+	profile.rule_bytes[profile.rule] += (size_t) (end - lexer->scan.end);
+
+	for(size_t j = lexer->scan.i;
+	j < i;
+	j += 1) {
+		profile.types[tokens[j].type % COUNT_TYPE] += 1;
+		// the qualifiers are in the highest bits
+		profile.subtypes[tokens[j].subtype % COUNT_SUBTYPE] += 1;
+	}
+}
+
+void lexer_profile_growth(
+size_t count_before,
+size_t count,
+size_t size_type) {
+	profile.growths += 1;
+	profile.growth_bytes += (count - count_before) * size_type;
+}
+
+/*
+ * one record per line, the fields are separated by a tabulation:
+ * rule <name> <hits> <bytes>
+ * type <name> <count>
+ * subtype <name> <count>
+ * allocator growths <count> <bytes>
+*/
+
+void lexer_profile_print(FILE* file) {
+	for(size_t rule = 0;
+	rule < LexerProfileRule_COUNT;
+	rule += 1) {
+		fprintf(
+			file,
+			"rule\t%s\t%zu\t%zu\n",
+			names_rule[rule],
+			profile.rule_hits[rule],
+			profile.rule_bytes[rule]);
+	}
+
+	for(size_t type = 0;
+	type < COUNT_TYPE;
+	type += 1) {
+		if(profile.types[type] == 0)
+			continue;
+
+		if(type < sizeof(names_type) / sizeof(*names_type))
+			fprintf(file, "type\t%s\t%zu\n", names_type[type], profile.types[type]);
+		else
+			fprintf(file, "type\t%zu\t%zu\n", type, profile.types[type]);
+	}
+
+	for(size_t subtype = 0;
+	subtype < COUNT_SUBTYPE;
+	subtype += 1) {
+		if(profile.subtypes[subtype] == 0)
+			continue;
+
+		if(subtype < sizeof(names_subtype) / sizeof(*names_subtype))
+			fprintf(file, "subtype\t%s\t%zu\n", names_subtype[subtype], profile.subtypes[subtype]);
+		else
+			fprintf(file, "subtype\t%zu\t%zu\n", subtype, profile.subtypes[subtype]);
+	}
+
+	fprintf(
+		file,
+		"allocator\tgrowths\t%zu\t%zu\n",
+		profile.growths,
+		profile.growth_bytes);
+}
+
+#undef COUNT_SUBTYPE
+#undef COUNT_TYPE
+#endif
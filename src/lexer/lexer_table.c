@@ -0,0 +1,3 @@
+#include "lexer_table.h"
+// generated in the object directory
+#include "lexer_table_data.h"
@@ -1,119 +1,78 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdio.h>
+#include "lexer_table.h"
 #include "lexer_utils.h"
 
+static bool has_class(
+char c,
+LexerClass class) {
+	return (lexer_classes[(uint8_t) c] & class) != 0;
+}
+
 TokenSubtype lexer_character_to_subtype(char c) {
-	switch(c) {
-	case '!': return TokenSubtype_EXCLAMATION_MARK;
-	case '"': return TokenSubtype_DQUOTES;
-	case '#': return TokenSubtype_HASH;
-	case '%': return TokenSubtype_MODULO;
-	case '&': return TokenSubtype_AMPERSAND;
-	case '\'': return TokenSubtype_SQUOTE;
-	case '(': return TokenSubtype_LPARENTHESIS;
-	case ')': return TokenSubtype_RPARENTHESIS;
-	case '*': return TokenSubtype_ASTERISK;
-	case '+': return TokenSubtype_PLUS;
-	case ',': return TokenSubtype_COMMA;
-	case '-': return TokenSubtype_MINUS;
-	case '.': return TokenSubtype_PERIOD;
-	case '/': return TokenSubtype_DIVIDE;
-	case ':': return TokenSubtype_COLON;
-	case ';': return TokenSubtype_SEMICOLON;
-	case '<': return TokenSubtype_LOBRACKET;
-	case '=': return TokenSubtype_EQUAL;
-	case '>': return TokenSubtype_ROBRACKET;
-	case '?': return TokenSubtype_QUESTION_MARK;
-	case '@': return TokenSubtype_AT;
-	case '[': return TokenSubtype_LBRACKET;
-	case ']': return TokenSubtype_RBRACKET;
-	case '\\': return TokenSubtype_BACKSLASH;
-	case '^': return TokenSubtype_CARET;
-	case '`': return TokenSubtype_GRAVE_ACCENT;
-	case '{': return TokenSubtype_LCBRACE;
-	case '|': return TokenSubtype_PIPE;
-	case '}': return TokenSubtype_RCBRACE;
-	case '~': return TokenSubtype_TILDE;
-	default: assert(false); // missing case
-	}
+	assert(lexer_subtypes[(uint8_t) c] != TokenSubtype_NO); // missing case
+	return (TokenSubtype) lexer_subtypes[(uint8_t) c];
 }
 
 bool isXdigit(char c) {
-	return isdigit(c)
-	    || (c >= 'A'
-		 && c <= 'F');
+	return has_class(
+		c,
+		LexerClass_XDIGIT);
 }
 
 bool lexer_is_delimiter_open(char c) {
-	return c == '('
-	    || c == '['
-	    || c == '{';
+	return has_class(
+		c,
+		LexerClass_DELIMITER_OPEN);
 }
 
 bool lexer_is_delimiter_close(char c) {
-	return c == ')'
-	    || c == ']'
-	    || c == '}';
+	return has_class(
+		c,
+		LexerClass_DELIMITER_CLOSE);
 }
 
 bool lexer_is_parenthesis(char c) {
-	return c == '('
-	    || c == ')';
+	return has_class(
+		c,
+		LexerClass_PARENTHESIS);
 }
 
 bool lexer_is_bracket(char c) {
-	return c == '['
-	    || c == ']';
+	return has_class(
+		c,
+		LexerClass_BRACKET);
 }
 
 bool lexer_is_delimiter(char c) {
-	return lexer_is_delimiter_open(c)
-	    || lexer_is_delimiter_close(c);
+	return has_class(
+		c,
+		LexerClass_DELIMITER_OPEN | LexerClass_DELIMITER_CLOSE);
 }
 
 bool lexer_is_command(char c) {
-	return c == '!'
-	    || c == '#'
-	    || c == '@';
+	return has_class(
+		c,
+		LexerClass_COMMAND);
 }
 // is interpreted when encountered alone
 bool lexer_is_interpreted(char c) {
-	return lexer_is_delimiter(c)
-	    || lexer_is_command(c)
-	    || c == '!'
-	    || c == '"'
-	    || c == '%'
-	    || c == '&'
-	    || c == '\''
-	    || c == '*'
-	    || c == '+'
-	    || c == ','
-	    || c == '-'
-	    || c == '.'
-	    || c == '/'
-	    || c == ';'
-	    || c == '<'
-	    || c == '='
-	    || c == '>'
-	    || c == '?'
-	    || c == '\\'
-	    || c == '^'
-	    || c == '`'
-	    || c == '|'
-	    || c == '~';
+	return has_class(
+		c,
+		LexerClass_INTERPRETED);
 }
 
 bool lexer_is_operator_leveling(char c) {
-	return c == '&'
-	    || c == '+'
-	    || c == '-'
-	    || c == '|';
+	return has_class(
+		c,
+		LexerClass_OPERATOR_LEVELING);
 }
 
 bool lexer_is_operator_modifier(char c) {
-	return lexer_is_operator_leveling(c)
-	    || lexer_is_bracket(c);
+	return has_class(
+		c,
+		LexerClass_OPERATOR_LEVELING | LexerClass_BRACKET);
 }
 
 bool lexer_is_operator(char c) {
@@ -129,7 +88,21 @@ bool lexer_is_operator(char c) {
 }
 
 bool lexer_is_special(char c) {
-	return lexer_is_interpreted(c) || c == ':';
+	return has_class(
+		c,
+		LexerClass_SPECIAL);
+}
+
+bool lexer_is_graph(char c) {
+	return has_class(
+		c,
+		LexerClass_GRAPH);
+}
+
+uint16_t lexer_get_rules(
+char first,
+char second) {
+	return lexer_rules[lexer_equivalences[(uint8_t) first]][lexer_equivalences[(uint8_t) second]];
 }
 
 bool lexer_delimiter_match(
@@ -155,32 +128,33 @@ long int end) {
 	assert(string != NULL);
 
 	string = string + start; // because start is left untouched
-	bool is_valid = isalpha(*string);
+
+	if(!has_class(
+		*string,
+		LexerClass_ALPHA))
+		return false;
 
 	for(long int i = 1;
 	i < end - start;
 	i += 1) {
-		const char c = string[i];
-		is_valid = is_valid
-			&& (isalpha(c)
-			 || isdigit(c)
-		     || c == '_');
+		if(!has_class(
+			string[i],
+			LexerClass_NAME))
+			return false;
 	}
 
-	return is_valid;
+	return true;
 }
 
 bool lexer_skip_glyphs_but_not_special(
 const char* string,
 long int* end) {
-	if(!isgraph(string[*end])
-	|| lexer_is_special(string[*end]))
+	if((lexer_classes[(uint8_t) string[*end]] & (LexerClass_GRAPH | LexerClass_SPECIAL)) != LexerClass_GRAPH)
 		return false;
 
 	do {
 		*end += 1;
-	} while(isgraph(string[*end])
-	     && !lexer_is_special(string[*end]));
+	} while((lexer_classes[(uint8_t) string[*end]] & (LexerClass_GRAPH | LexerClass_SPECIAL)) == LexerClass_GRAPH);
 
 	return true;
 }
@@ -188,8 +162,7 @@ long int* end) {
 void lexer_skip_controls_and_spaces_but_not_eof(
 const char* string,
 long int* end) {
-	while(string[*end] != '\0'
-	   && !isgraph(string[*end])) *end += 1;
+	while(lexer_equivalences[(uint8_t) string[*end]] == LexerEquivalence_BLANK) *end += 1;
 }
 
 bool lexer_get_next_word_immediate(
@@ -224,6 +197,24 @@ long int* restrict end) {
 		end);
 }
 
+// FNV-1a
+uint64_t lexer_hash(
+const char* string,
+size_t length) {
+	assert(string != NULL);
+
+	uint64_t hash = 0xCBF29CE484222325;
+
+	for(size_t i = 0;
+	i < length;
+	i += 1) {
+		hash ^= (uint8_t) string[i];
+		hash *= 0x100000001B3;
+	}
+
+	return hash;
+}
+
 bool lexer_skip_comment(
 const char* string,
 long int* restrict start,
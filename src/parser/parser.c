@@ -2,21 +2,26 @@
 #include <string.h>
 #include "parser.h"
 #include "parser_allocator.h"
+#include "parser_cache.h"
 #include "parser_call.h"
 #include "parser_error.h"
 #include "parser_identifier.h"
+#include "parser_incremental.h"
 #include "parser_module.h"
+#include "parser_parallel.h"
 #include "parser_scope.h"
+#include "parser_signature.h"
+#include "parser_symbol.h"
 #include "parser_utils.h"
 #include <stdio.h>
 
-static int error = 0;
-
-static int set_error(int value) {
-	if(error == -1)
+static int set_error(
+int value,
+int* error) {
+	if(*error == -1)
 		return -1;
 
-	error = value;
+	*error = value;
 	return value;
 }
 
@@ -25,152 +30,271 @@ void initialize_parser(Parser* parser) {
 	parser_initialize_allocators(parser);
 }
 
-static bool parse_scope_file(
-MemoryArea* restrict memArea,
+// the parameters of a label are visible in its scope
+static bool add_parameters(
+uint32_t node_label,
 Parser* parser) {
-	size_t i = 0;
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
-	// the counter is triggered when the first parameterized label is encountered
-	size_t count_scope_nest = 0;
-	// to insert declarations in the right place
-	const MemoryChain buffer_memChain = parser->nodes;
-	parser->nodes = parser->declarations;
-
-	while(i < parser->lexer->tokens.count - 1) {
-		Node* node_identification;
-
-		if(parser_is_scope_L(tokens + i)) {
-			if(count_scope_nest > 0)
-				count_scope_nest += 1;
 
-			i += 1;
-		} else if(tokens[i].subtype == TokenSubtype_PERIOD) {
-			if(count_scope_nest > 0)
-				count_scope_nest -= 1;
-
-			i += 1;
-		}
+	for(uint32_t child1 = parser_allocator_node(
+		parser,
+		node_label)->child1;
+	child1 != 0;
+	child1 = parser_allocator_node(
+		parser,
+		child1)->child1) {
+		const Node* node = parser_allocator_node(
+			parser,
+			child1);
 
-		if(count_scope_nest == 0
-		&& set_error(
-			if_declaration_create_nodes(
-				&i,
-				memArea,
-				&node_identification,
-				parser))
-		== 1) {
-			if((node_identification->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED)
-			== NodeSubtypeIdentificationBitScoped_LABEL_PARAMETERIZED)
-				count_scope_nest += 1;
-		} else
-			i += 1;
+		if(node->type != NodeTypeChildType_LOCK
+		|| node->subtype != NodeSubtypeChildTypeScoped_PARAMETER
+		|| node->token == 0)
+			continue;
 
-		if(error == -1)
+		if(parser_symbol_add(
+			parser_symbol_name(
+				parser->lexer,
+				tokens + node->token),
+			child1,
+			&parser->symbols)
+		== false)
 			return false;
 	}
 
-	parser->nodes = buffer_memChain;
 	return true;
 }
 
-bool create_parser(
-const Lexer* lexer,
-MemoryArea* restrict memArea,
+/*
+ * parse the instructions from the token `i` to the token `end` (excluded) after the nodes already created
+ * the scopes still open at `end` are left in `Parser.scopes`
+*/
+bool parser_parse_tokens(
+size_t i,
+size_t end,
 Parser* parser) {
 	assert(parser != NULL);
-	assert(lexer != NULL);
-	assert(memArea != NULL);
 
-	parser->lexer = lexer;
+	const Lexer* lexer = parser->lexer;
 	const Token* tokens = (const Token*) lexer->tokens.addr;
-	size_t i = 1;
-	Node* buffer_node = NULL;
-	Node* buffer_node_previous = NULL;
-	Node* parameterized_label_current = NULL;
+	int error = 0;
+	// indexes in `Parser.nodes`, the null node if none
+	uint32_t buffer_node = 0;
+	uint32_t buffer_node_previous = 0;
+	uint32_t parameterized_label_current = 0;
+	// not within an instruction, like a label before its scope
+	bool is_top = true;
 
-	if(!parser_scan_errors(lexer))
-		return false;
+	while(i < end) {
+		// the check of the end of an instruction only depends on its own nodes
+		buffer_node = 0;
 
-	if(!parser_create_allocators(parser))
-		return false;
+		if(is_top
+		&& parser->count_scopes == 0) {
+			if(!parser_allocator_top(parser))
+				return false;
 
-	if(parse_scope_file(
-		memArea,
-		parser)
-	== false)
-		goto DESTROY;
+			((ParserTop*) parser->tops.addr)[parser->count_tops] = (ParserTop) {
+				.token = (uint32_t) i,
+				.node = (uint32_t) parser->count_nodes};
+			parser->count_tops += 1;
+		}
 
-	while(i < lexer->tokens.count - 1) {
-		// create nodes
-		if(set_error(
-			if_module_create_nodes(
+		// create nodes, the construct being known no attempt is rolled back
+		switch(parser_lookahead(
+			i,
+			parser)) {
+		case ParserConstruct_NO: break;
+		case ParserConstruct_MODULE:
+			if(if_module_create_nodes(
 				&i,
-				parser))
-		== 1) {
-			// OK
-		} else if(parser_is_scope_L(tokens + i)) {
+				parser)
+			!= 1)
+				return false;
+
+			buffer_node = parser_allocator_index(parser);
+			break;
+		case ParserConstruct_SCOPE:
 			while(if_scope_create_node(
 				i,
 				parser)
 			== true) {
-				buffer_node = parser->nodes.top;
+				buffer_node = parser_allocator_index(parser);
+				Node* const previous = parser_allocator_node(
+					parser,
+					buffer_node_previous);
 
-				if(buffer_node_previous != NULL
-				&& (buffer_node_previous->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED)) {
+				if(previous->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED) {
 					// nested parameterized label
-					if(parameterized_label_current != NULL
+					if(parameterized_label_current != 0
 					// declarations are allowed
-					&& (parameterized_label_current->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE)
+					&& (parser_allocator_node(
+						parser,
+						parameterized_label_current)->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_TYPE)
 					 != NodeSubtypeIdentificationBitType_DECLARATION)
-						goto DESTROY;
+						return false;
 					// `child2` is set to the scope
-					buffer_node_previous->child2 = buffer_node;
+					previous->child2 = buffer_node;
+
+					if(!add_parameters(
+						buffer_node_previous,
+						parser))
+						return false;
 				}
 
 				parameterized_label_current = buffer_node;
 				i += 1;
 			}
-		} else if(set_error(
-			if_identification_create_nodes(
+
+			break;
+		case ParserConstruct_IDENTIFICATION:
+			if(if_identification_create_nodes(
 				&i,
-				memArea,
 				&buffer_node,
+				parser)
+			!= 1
+			|| parser_symbol_add(
+				parser_symbol_name(
+					lexer,
+					tokens + parser_allocator_node(
+						parser,
+						buffer_node)->token),
+				buffer_node,
+				&parser->symbols)
+			== false
+			|| !parser_signature_add(
+				buffer_node,
 				parser))
-		== 1) {
-			// OK
-		} else if(set_error(
-			if_call_create_nodes(
+				return false;
+
+			break;
+		case ParserConstruct_CALL:
+			if(if_call_create_nodes(
 				&i,
-				parser))
-		== 1) {
-			// OK
+				parser)
+			!= 1)
+				return false;
+
+			buffer_node = parser_allocator_index(parser);
+			break;
 		}
+
+		const NodeType type_buffer_node = parser_allocator_node(
+			parser,
+			buffer_node)->type;
 		// check end of scope (period) or end of instruction (semicolon)
 		if(set_error(
 			if_period_create_node(
 				i,
-				parser))
+				parser),
+			&error)
 		== 1) {
-			parameterized_label_current = NULL;
+			parameterized_label_current = 0;
+			is_top = true;
 			i += 1;
 		} else if(tokens[i].subtype == TokenSubtype_SEMICOLON) {
+			is_top = true;
 			i += 1;
-		} else if(buffer_node->type == NodeType_SCOPE_START
-		       || (buffer_node->type == NodeType_IDENTIFICATION
+		} else if(type_buffer_node == NodeType_SCOPE_START
+		       || (type_buffer_node == NodeType_IDENTIFICATION
 		        && parser_is_scope_L(tokens + i))) {
-			// OK
+			is_top = false;
 		} else
-			goto DESTROY;
+			return false;
 		// error checking
 		if(error == -1)
-			goto DESTROY;
+			return false;
 
 		buffer_node_previous = buffer_node;
 	}
-/*
-	if(j == 1)
+
+	return true;
+}
+
+// the calls of the labels identified later are resolved once all the nodes are created
+static bool finish_parser(Parser* parser) {
+	if(!parser_call_resolve(parser))
+		return false;
+	// not being able to write the AST file is not an error
+	if(parser->count_scopes == 0)
+		parser_cache_store(parser);
+
+	return true;
+}
+
+static bool parse_file(Parser* parser) {
+	// an unchanged source is not parsed again
+	if(parser_cache_load(parser))
+		return true;
+	// a large file is split between several threads
+	switch(parser_parallel_create(parser)) {
+	case -1: goto DESTROY;
+	case 0:
+		if(!parser_create_allocators(parser)
+		|| !parser_parse_tokens(
+			1,
+			parser->lexer->tokens.count - 1,
+			parser))
+			goto DESTROY;
+
+		break;
+	}
+
+	if(!finish_parser(parser))
 		goto DESTROY;
+
+	return true;
+DESTROY:
+	destroy_parser(parser);
+	return false;
+}
+
+bool create_parser(
+const Lexer* lexer,
+Parser* parser) {
+	assert(parser != NULL);
+	assert(lexer != NULL);
+
+	parser->lexer = lexer;
+
+	if(!parser_scan_errors(lexer))
+		return false;
+
+	return parse_file(parser);
+}
+
+/*
+ * parse again only the instructions at file scope touched by the edits of the tokens since `previous`,
+ * which must not be destroyed before
 */
+bool create_parser_incremental(
+const Lexer* lexer,
+const Parser* previous,
+const ParserEdit* edits,
+size_t count_edits,
+Parser* parser) {
+	assert(parser != NULL);
+	assert(lexer != NULL);
+	assert(previous != NULL);
+
+	parser->lexer = lexer;
+
+	if(!parser_scan_errors(lexer))
+		return false;
+
+	switch(parser_incremental_create(
+		previous,
+		edits,
+		count_edits,
+		parser)) {
+	case -1: goto DESTROY;
+	case 0:
+		return parse_file(parser);
+	}
+
+	if(!finish_parser(parser))
+		goto DESTROY;
+
 	return true;
 DESTROY:
 	destroy_parser(parser);
@@ -2,137 +2,242 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "parser_allocator.h"
-
-#define CHUNK 1
+#include "parser_cache.h"
+#include "parser_qualifier.h"
+#include "parser_signature.h"
+#include "parser_symbol.h"
+#include "parser_type_table.h"
+
+#define CHUNK 256
+#define CHUNK_FIXUP 16
+#define CHUNK_SCOPE 16
+#define CHUNK_NEST 16
+#define CHUNK_EXPRESSION 64
+#define CHUNK_TOP 64
 
 void parser_initialize_allocators(Parser* parser) {
 	assert(parser != NULL);
 
-	initialize_memory_chain(&parser->nodes);
-	initialize_memory_chain(&parser->declarations);
+	initialize_memory_area(&parser->nodes);
+	parser->count_nodes = 0;
+	parser_initialize_symbols(&parser->symbols);
+	parser_initialize_types(&parser->types);
+	parser_initialize_signatures(&parser->signatures);
+	parser_initialize_qualifiers(&parser->qualifiers);
+	initialize_memory_area(&parser->fixups);
+	parser->count_fixups = 0;
+	initialize_memory_area(&parser->scopes);
+	parser->count_scopes = 0;
+	initialize_memory_area(&parser->nests);
+	parser->count_nests = 0;
+	initialize_memory_area(&parser->operators);
+	initialize_memory_area(&parser->operands);
+	initialize_memory_area(&parser->tops);
+	parser->count_tops = 0;
+	parser->cache_addr = NULL;
+	parser->cache_length = 0;
+}
+
+// room for one more element after `count` ones
+static bool area_grow(
+size_t count,
+MemoryArea* memArea) {
+	if(count < memArea->count)
+		return true;
+
+	return memory_area_realloc(
+		memArea->count * 2,
+		memArea);
 }
 
 bool parser_create_allocators(Parser* parser) {
 	assert(parser != NULL);
-	// the first node is null
-	if(create_memory_chain(
+
+	if(create_memory_area(
 		CHUNK,
 		sizeof(Node),
 		&parser->nodes)
 	== false)
 		return false;
+	// the first node is null
+	*((Node*) parser->nodes.addr) = (Node) {
+		.type = NodeType_NO};
+	parser->count_nodes = 1;
+
+	if(!parser_create_symbols(&parser->symbols)
+	|| !parser_create_types(&parser->types)
+	|| !parser_create_signatures(&parser->signatures)
+	|| !parser_create_qualifiers(&parser->qualifiers))
+		return false;
 
-	if(create_memory_chain(
-		CHUNK,
-		sizeof(Node),
-		&parser->declarations)
+	if(create_memory_area(
+		CHUNK_FIXUP,
+		sizeof(ParserFixup),
+		&parser->fixups)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_SCOPE,
+		sizeof(ParserScope),
+		&parser->scopes)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_NEST,
+		sizeof(ParserTypeNest),
+		&parser->nests)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_EXPRESSION,
+		sizeof(ParserExpressionOperator),
+		&parser->operators)
+	== false
+	|| create_memory_area(
+		CHUNK_EXPRESSION,
+		sizeof(uint32_t),
+		&parser->operands)
+	== false)
+		return false;
+
+	if(create_memory_area(
+		CHUNK_TOP,
+		sizeof(ParserTop),
+		&parser->tops)
 	== false)
 		return false;
 
+	parser->count_fixups = 0;
+	parser->count_scopes = 0;
+	parser->count_nests = 0;
+	parser->count_tops = 0;
 	return true;
 }
 
 void parser_destroy_allocators(Parser* parser) {
 	assert(parser != NULL);
 
-	destroy_memory_chain(&parser->declarations);
-	destroy_memory_chain(&parser->nodes);
+	destroy_memory_area(&parser->tops);
+	destroy_memory_area(&parser->operands);
+	destroy_memory_area(&parser->operators);
+	destroy_memory_area(&parser->nests);
+	destroy_memory_area(&parser->scopes);
+	destroy_memory_area(&parser->fixups);
+	parser_destroy_qualifiers(&parser->qualifiers);
+	parser_destroy_signatures(&parser->signatures);
+	parser_destroy_types(&parser->types);
+	parser_destroy_symbols(&parser->symbols);
+
+	if(parser->cache_addr != NULL)
+		parser_cache_unmap(parser);
+	else
+		destroy_memory_area(&parser->nodes);
 }
 
+// one more node at the end of `Parser.nodes`, the pointers to the nodes may be invalidated
 bool parser_allocator(Parser* parser) {
 	assert(parser != NULL);
 
-	return memory_chain_reserve_data(
-		CHUNK,
-		&parser->nodes);
-}
+	if(parser->count_nodes == UINT32_MAX)
+		return false;
 
-void parser_allocator_next_link(
-const Node* node,
-const MemoryChainLink** link) {
-	assert(node != NULL);
-	assert(link != NULL);
+	if(!area_grow(
+		parser->count_nodes,
+		&parser->nodes))
+		return false;
 
-	if(node == (Node*) (*link)->memArea.addr + (*link)->memArea.count - 1)	
-		*link = (*link)->next;
+	parser->count_nodes += 1;
+	return true;
 }
 
-bool parser_allocator_next(
-const Parser* parser,
-const MemoryChainLink** link,
-const Node** node) {
+// room for `count` more nodes, added by the caller
+bool parser_allocator_reserve(
+size_t count,
+Parser* parser) {
 	assert(parser != NULL);
-	assert(link != NULL);
-	assert(node != NULL);
 
-	if(*node == (Node*) (*link)->memArea.addr + (*link)->memArea.count - 1) {
-		if((*link)->next == NULL)
-			return false;
+	const size_t count_needed = parser->count_nodes + count;
 
-		*link = (*link)->next;
-		*node = (Node*) (*link)->memArea.addr;
-	} else
-		*node += 1;
+	if(count_needed > UINT32_MAX)
+		return false;
 
-	return true;
+	if(count_needed <= parser->nodes.count)
+		return true;
+
+	return memory_area_realloc(
+		count_needed > parser->nodes.count * 2 ? count_needed : parser->nodes.count * 2,
+		&parser->nodes);
 }
 
-const Node* parser_allocator_start_node(
-const Parser* parser,
-const MemoryChainLink** link) {
+bool parser_allocator_fixup(Parser* parser) {
 	assert(parser != NULL);
-	assert(link != NULL);
-
-	Node* node;
 
-	if(parser->nodes.first->memArea.count > 1) {
-		*link = parser->nodes.first;
-		node = (Node*) (*link)->memArea.addr + 1;
-	} else if(parser->nodes.first->next != NULL) {
-		*link = parser->nodes.first->next;
-		node = (Node*) (*link)->memArea.addr;
-	} else
-		return NULL;
+	return area_grow(
+		parser->count_fixups,
+		&parser->fixups);
+}
+// the stack of the open scopes has room for one more scope
+bool parser_allocator_scope(Parser* parser) {
+	assert(parser != NULL);
 
-	return node;
+	return area_grow(
+		parser->count_scopes,
+		&parser->scopes);
 }
 
-bool parser_allocator_continue_node(
-const Parser* parser,
-const Node* node) {
+// the stack of the parentheses of a type has room for one more
+bool parser_allocator_nest(Parser* parser) {
 	assert(parser != NULL);
-	assert(node != NULL);
 
-	return node != (Node*) parser->nodes.last->memArea.addr + parser->nodes.last->memArea.count;
+	return area_grow(
+		parser->count_nests,
+		&parser->nests);
 }
 
-const Node* parser_allocator_start_declaration(
-const Parser* parser,
-const MemoryChainLink** link) {
+// the stacks of the expression being parsed have room for one more operator and operand
+bool parser_allocator_expression(
+size_t count_operators,
+size_t count_operands,
+Parser* parser) {
 	assert(parser != NULL);
-	assert(link != NULL);
 
-	Node* node;
+	return area_grow(
+		count_operators,
+		&parser->operators)
+	    && area_grow(
+		count_operands,
+		&parser->operands);
+}
+
+bool parser_allocator_top(Parser* parser) {
+	assert(parser != NULL);
 
-	if(parser->nodes.first->memArea.count > 1) {
-		*link = parser->declarations.first;
-		node = (Node*) (*link)->memArea.addr + 1;
-	} else if(parser->declarations.first->next != NULL) {
-		*link = parser->declarations.first->next;
-		node = (Node*) (*link)->memArea.addr;
-	} else
-		return NULL;
+	return area_grow(
+		parser->count_tops,
+		&parser->tops);
+}
+// index of the last node in `Parser.nodes`
+uint32_t parser_allocator_index(const Parser* parser) {
+	assert(parser != NULL);
 
-	return node;
+	return (uint32_t) (parser->count_nodes - 1);
 }
 
-bool parser_allocator_continue_declaration(
+Node* parser_allocator_node(
 const Parser* parser,
-const Node* node) {
+uint32_t index) {
 	assert(parser != NULL);
-	assert(node != NULL);
+	assert(index < parser->count_nodes);
 
-	return node != (Node*) parser->declarations.last->memArea.addr + parser->declarations.last->memArea.count;
+	return (Node*) parser->nodes.addr + index;
 }
 
+#undef CHUNK_TOP
+#undef CHUNK_EXPRESSION
+#undef CHUNK_NEST
+#undef CHUNK_SCOPE
+#undef CHUNK_FIXUP
 #undef CHUNK
@@ -0,0 +1,365 @@
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lexer_cache.h"
+#include "lexer_utils.h"
+#include "parser_cache.h"
+#include "parser_qualifier.h"
+#include "parser_signature.h"
+#include "parser_symbol.h"
+#include "parser_type_table.h"
+
+/*
+ * an AST file is named after the hash of the source content and is laid out as:
+ * - header
+ * - nodes, file scope symbols (each one aligned on 8 bytes)
+ * every reference is an index (in `Parser.nodes` or `Lexer.tokens`) so the file is mapped as is,
+ * by the next build or by another process holding the tokens of the same source
+ * the symbols only keep the index of their node, the names are interned again when loading.
+ * the qualifiers without a bit are read again from the tokens.
+ * the files go in the directory of the token files, none if the cache is off.
+*/
+
+#define PARSER_CACHE_MAGIC 0x414C454B // "KELA"
+// to be incremented whenever the layout or the parsing changes
+#define PARSER_CACHE_VERSION 4
+#define LENGTH_PATH 4096
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t hash;
+	uint64_t length; // of the source
+	uint32_t size_node;
+	uint32_t size_token;
+	uint64_t count_tokens;
+	uint64_t count_nodes;
+	uint64_t count_symbols;
+} ParserCacheHeader;
+
+static size_t align(size_t size) {
+	return (size + 7) & ~(size_t) 7;
+}
+
+static uint64_t source_hash(const Source* source) {
+	return lexer_hash(
+		source->content + 1,
+		(size_t) source->length);
+}
+
+// false if the path does not fit
+static bool cache_path(
+const char* directory,
+uint64_t hash,
+const char* suffix,
+char* path) {
+	const int length = snprintf(
+		path,
+		LENGTH_PATH,
+		"%s/%016" PRIX64 ".kelast%s",
+		directory,
+		hash,
+		suffix);
+	return length > 0
+	    && length < LENGTH_PATH;
+}
+
+static bool load_symbols(
+const uint32_t* symbols,
+size_t count_symbols,
+Parser* parser) {
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+
+	if(!parser_create_symbols(&parser->symbols))
+		return false;
+
+	for(size_t i = 0;
+	i < count_symbols;
+	i += 1) {
+		if(symbols[i] == 0
+		|| symbols[i] >= parser->count_nodes)
+			return false;
+
+		const Node* node = (const Node*) parser->nodes.addr + symbols[i];
+
+		if(node->token >= parser->lexer->tokens.count
+		|| parser_symbol_add(
+			parser_symbol_name(
+				parser->lexer,
+				tokens + node->token),
+			symbols[i],
+			&parser->symbols)
+		== false)
+			return false;
+	}
+
+	return true;
+}
+
+// the signatures, with the types they intern, and the qualifiers without a bit are read again from the identifications
+static bool load_identifications(Parser* parser) {
+	if(!parser_create_types(&parser->types)
+	|| !parser_create_signatures(&parser->signatures)
+	|| !parser_create_qualifiers(&parser->qualifiers))
+		return false;
+
+	for(uint32_t i = 1;
+	i < parser->count_nodes;
+	i += 1) {
+		const Node* node = (const Node*) parser->nodes.addr + i;
+
+		if(!parser_signature_add(
+			i,
+			parser)
+		|| (!node->is_child
+		 && node->type == NodeType_IDENTIFICATION
+		 && (node->subtype & NodeSubtypeIdentificationBitQualifier_CUSTOM)
+		 && !parser_qualifier_add(
+			i,
+			parser)))
+			return false;
+	}
+
+	return true;
+}
+// the parser is complete, no node can be added to the mapped ones
+bool parser_cache_load(Parser* parser) {
+	assert(parser != NULL);
+	assert(parser->lexer != NULL);
+
+	const Lexer* lexer = parser->lexer;
+	const uint64_t hash = source_hash(lexer->source);
+	const char* directory = lexer_cache_directory();
+	char path[LENGTH_PATH];
+
+	if(directory == NULL
+	|| !cache_path(
+		directory,
+		hash,
+		"",
+		path))
+		return false;
+
+	const int file = open(
+		path,
+		O_RDONLY);
+
+	if(file == -1)
+		return false;
+
+	struct stat status;
+
+	if(fstat(
+		file,
+		&status)
+	== -1
+	|| (size_t) status.st_size < align(sizeof(ParserCacheHeader))) {
+		close(file);
+		return false;
+	}
+
+	char* const addr = mmap(
+		NULL,
+		(size_t) status.st_size,
+		PROT_READ | PROT_WRITE, // copy on write
+		MAP_PRIVATE,
+		file,
+		0);
+	close(file);
+
+	if(addr == MAP_FAILED)
+		return false;
+
+	const ParserCacheHeader* header = (const ParserCacheHeader*) addr;
+	// the counts of the file are bounded by its size before any size is computed from them
+	const size_t size_area = (size_t) status.st_size - align(sizeof(ParserCacheHeader));
+
+	if(header->magic != PARSER_CACHE_MAGIC
+	|| header->version != PARSER_CACHE_VERSION
+	|| header->hash != hash
+	|| header->length != (uint64_t) lexer->source->length
+	|| header->size_node != sizeof(Node)
+	|| header->size_token != sizeof(Token)
+	|| header->count_tokens != lexer->tokens.count
+	|| header->count_nodes == 0
+	|| header->count_nodes > UINT32_MAX
+	|| header->count_nodes > size_area / sizeof(Node)
+	|| header->count_symbols > header->count_nodes
+	|| align(header->count_nodes * sizeof(Node)) + align(header->count_symbols * sizeof(uint32_t)) != size_area) {
+		munmap(
+			addr,
+			(size_t) status.st_size);
+		return false;
+	}
+
+	const size_t size_nodes = align(header->count_nodes * sizeof(Node));
+	char* const area = addr + align(sizeof(ParserCacheHeader));
+	parser->nodes = (MemoryArea) {
+		.addr = area,
+		.count = header->count_nodes,
+		.size_type = sizeof(Node)};
+	parser->count_nodes = header->count_nodes;
+	parser->cache_addr = addr;
+	parser->cache_length = (size_t) status.st_size;
+
+	if(!load_symbols(
+		(const uint32_t*) (area + size_nodes),
+		header->count_symbols,
+		parser)
+	|| !load_identifications(parser)) {
+		parser_destroy_qualifiers(&parser->qualifiers);
+		parser_destroy_signatures(&parser->signatures);
+		parser_destroy_types(&parser->types);
+		parser_destroy_symbols(&parser->symbols);
+		parser_cache_unmap(parser);
+		return false;
+	}
+
+	return true;
+}
+
+// without an address, only the padding is written
+static bool write_area(
+const void* addr,
+size_t size,
+FILE* file) {
+	static const char padding[8] = {0};
+
+	if(addr == NULL)
+		return fwrite(
+			padding,
+			1,
+			size,
+			file) == size;
+
+	if(size != 0
+	&& fwrite(
+		addr,
+		1,
+		size,
+		file)
+	!= size)
+		return false;
+
+	return fwrite(
+		padding,
+		1,
+		align(size) - size,
+		file) == align(size) - size;
+}
+// only a complete tree with its scopes closed is stored
+bool parser_cache_store(const Parser* parser) {
+	assert(parser != NULL);
+	assert(parser->cache_addr == NULL);
+	assert(parser->count_scopes == 0);
+	assert(parser->count_fixups == 0);
+
+	const ParserCacheHeader header = {
+		.magic = PARSER_CACHE_MAGIC,
+		.version = PARSER_CACHE_VERSION,
+		.hash = source_hash(parser->lexer->source),
+		.length = (uint64_t) parser->lexer->source->length,
+		.size_node = sizeof(Node),
+		.size_token = sizeof(Token),
+		.count_tokens = parser->lexer->tokens.count,
+		.count_nodes = parser->count_nodes,
+		.count_symbols = parser->symbols.count_symbols};
+	const char* directory = lexer_cache_directory();
+	char path[LENGTH_PATH];
+	char path_tmp[LENGTH_PATH];
+
+	if(directory == NULL
+	|| !cache_path(
+		directory,
+		header.hash,
+		"",
+		path)
+	|| !cache_path(
+		directory,
+		header.hash,
+		".tmp",
+		path_tmp))
+		return false;
+
+	if(mkdir(
+		directory,
+		0755)
+	== -1
+	&& access(
+		directory,
+		W_OK)
+	== -1)
+		return false;
+
+	FILE* file = fopen(
+		path_tmp,
+		"wb");
+
+	if(file == NULL)
+		return false;
+
+	bool error = !write_area(
+		&header,
+		sizeof(ParserCacheHeader),
+		file)
+	|| !write_area(
+		parser->nodes.addr,
+		header.count_nodes * sizeof(Node),
+		file);
+	// the names are not stored, their IDs are only valid in this process
+	const ParserSymbol* symbols = (const ParserSymbol*) parser->symbols.symbols.addr;
+
+	for(size_t i = 0;
+	i < header.count_symbols
+	&& !error;
+	i += 1) {
+		error = fwrite(
+			&symbols[i].node,
+			sizeof(uint32_t),
+			1,
+			file)
+		!= 1;
+	}
+
+	if(!error)
+		error = !write_area(
+			NULL,
+			align(header.count_symbols * sizeof(uint32_t)) - header.count_symbols * sizeof(uint32_t),
+			file);
+
+	if(fclose(file) == EOF)
+		error = true;
+	// a partial file is never visible under the final name
+	if(error
+	|| rename(
+		path_tmp,
+		path)
+	!= 0) {
+		remove(path_tmp);
+		return false;
+	}
+
+	return true;
+}
+
+void parser_cache_unmap(Parser* parser) {
+	assert(parser != NULL);
+	assert(parser->cache_addr != NULL);
+
+	munmap(
+		parser->cache_addr,
+		parser->cache_length);
+	parser->cache_addr = NULL;
+	parser->cache_length = 0;
+	initialize_memory_area(&parser->nodes);
+	parser->count_nodes = 0;
+}
+
+#undef LENGTH_PATH
+#undef PARSER_CACHE_VERSION
+#undef PARSER_CACHE_MAGIC
@@ -1,49 +1,221 @@
 #include <assert.h>
-#include <string.h>
 #include "parser_allocator.h"
 #include "parser_call.h"
-#include <stdio.h>
+#include "parser_signature.h"
+#include "parser_symbol.h"
+#include "parser_utils.h"
 
-int if_call_create_nodes(
-size_t* i,
+// only the labels can be called for the moment
+static bool is_label(const Node* node) {
+	return node->type == NodeType_IDENTIFICATION
+	    && node->is_child == false
+	    && (node->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED)
+	    != NodeSubtypeIdentificationBitScoped_NO;
+}
+
+// a call with parentheses passes one argument per parameter of a parameterized label
+static bool is_callable(
+uint32_t node,
+uint32_t declaration,
+const Parser* parser) {
+	if(!is_label(parser_allocator_node(
+		parser,
+		declaration)))
+		return false;
+
+	const Node* call = parser_allocator_node(
+		parser,
+		node);
+	const ParserSignature* signature = parser_signature_find(
+		declaration,
+		parser);
+
+	if(signature == NULL
+	|| (call->subtype & MASK_BIT_NODE_SUBTYPE_CALL_ARGUMENTS) == NodeSubtypeCallBitArguments_FALSE)
+		return true;
+
+	size_t count_arguments = 0;
+
+	for(uint32_t argument = call->child2;
+	argument != 0;
+	argument = parser_allocator_node(
+		parser,
+		argument)->child2) count_arguments += 1;
+
+	return count_arguments == signature->count_parameters;
+}
+
+/*
+ * set `child1` of a call or of a key in an expression to the identification of its name
+ * a name not visible yet is fixed up later, at the end of the unit or of the file
+*/
+bool parser_call_bind(
+uint32_t node,
 Parser* parser) {
-	return 0;
-	const char* code = parser->lexer->source->content;
+	assert(parser != NULL);
+
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
-	size_t buffer_i = *i;
-	const MemoryChainLink* declaration_link;
-	const Node* declaration_node = parser_allocator_start_declaration(
+	const uint32_t token = parser_allocator_node(
 		parser,
-		&declaration_link);
+		node)->token;
+	const uint32_t declaration = parser_symbol_find(
+		parser_symbol_name(
+			parser->lexer,
+			tokens + token),
+		&parser->symbols);
 
-	if(declaration_node == NULL)
-		return 0;
+	if(declaration != 0) {
+		if(parser_allocator_node(
+			parser,
+			node)->type == NodeType_CALL
+		&& !is_callable(
+			node,
+			declaration,
+			parser))
+			return false;
 
-	while(parser_allocator_continue_declaration(
-		parser,
-		declaration_node)
-	== true) {
-		if(declaration_node->type == NodeType_NO)
-			break;
-
-		if(strncmp(
-			code + declaration_node->token->L_start,
-			code + tokens[buffer_i].L_start,
-			declaration_node->token->L_end - declaration_node->token->L_start)
-		== 0)
-			goto FOUND;
-
-		if(parser_allocator_next(
+		parser_allocator_node(
 			parser,
-			&declaration_link,
-			&declaration_node)
-		== false)
-			break;
+			node)->child1 = declaration;
+		return true;
 	}
 
-	return 0;
-FOUND:
-	printf("FOUND!\n");
+	if(!parser_allocator_fixup(parser))
+		return false;
+
+	((ParserFixup*) parser->fixups.addr)[parser->count_fixups] = (ParserFixup) {
+		.node = node,
+		.token = token};
+	parser->count_fixups += 1;
+	return true;
+}
+
+// `child1` points to the identification of the called name
+int if_call_create_nodes(
+size_t* i,
+Parser* parser) {
+	assert(i != NULL);
+	assert(parser != NULL);
+
+	size_t buffer_i = *i;
+	// a key alone ending the instruction in a scope, like in `lab;`
+	assert(parser_lookahead(
+		buffer_i,
+		parser)
+	== ParserConstruct_CALL);
+
+	if(!parser_allocator(parser))
+		return -1;
+
+	const uint32_t node_call = parser_allocator_index(parser);
+	*parser_allocator_node(
+		parser,
+		node_call) = (Node) {
+		.is_child = false,
+		.type = NodeType_CALL,
+		.subtype = NodeSubtypeCallBitTime_BINARY,
+		.token = (uint32_t) buffer_i,
+		.child1 = 0,
+		.child2 = 0};
+
+	if(!parser_call_bind(
+		node_call,
+		parser))
+		return -1;
+
 	*i = buffer_i + 1;
 	return 1;
 }
+
+// the calls not resolved in a unit parsed apart, whose nodes are moved to `map` in the parser
+bool parser_call_resolve_unit(
+const Parser* unit,
+const uint32_t* map,
+Parser* parser) {
+	assert(unit != NULL);
+	assert(parser != NULL);
+
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	const ParserFixup* fixups = (const ParserFixup*) unit->fixups.addr;
+
+	for(size_t i = 0;
+	i < unit->count_fixups;
+	i += 1) {
+		const uint32_t node_call = map[fixups[i].node];
+		// identified in a previous unit
+		const uint32_t declaration = parser_symbol_find(
+			parser_symbol_name(
+				parser->lexer,
+				tokens + fixups[i].token),
+			&parser->symbols);
+
+		const bool is_call = parser_allocator_node(
+			parser,
+			node_call)->type == NodeType_CALL;
+
+		if(declaration != 0) {
+			if(is_call
+			&& !is_callable(
+				node_call,
+				declaration,
+				parser))
+				return false;
+
+			parser_allocator_node(
+				parser,
+				node_call)->child1 = declaration;
+			continue;
+		}
+		// a key is not visible before its identification
+		if(!is_call)
+			continue;
+		// a call may be identified later in the file
+		if(!parser_allocator_fixup(parser))
+			return false;
+
+		((ParserFixup*) parser->fixups.addr)[parser->count_fixups] = (ParserFixup) {
+			.node = node_call,
+			.token = fixups[i].token};
+		parser->count_fixups += 1;
+	}
+
+	return true;
+}
+
+// at the end of the file, a name called before its identification is looked up at file scope
+bool parser_call_resolve(Parser* parser) {
+	assert(parser != NULL);
+
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	const ParserFixup* fixups = (const ParserFixup*) parser->fixups.addr;
+
+	for(size_t i = 0;
+	i < parser->count_fixups;
+	i += 1) {
+		// the keys of the expressions are left unresolved
+		if(parser_allocator_node(
+			parser,
+			fixups[i].node)->type != NodeType_CALL)
+			continue;
+
+		const uint32_t declaration = parser_symbol_find(
+			parser_symbol_name(
+				parser->lexer,
+				tokens + fixups[i].token),
+			&parser->symbols);
+
+		if(declaration == 0
+		|| !is_callable(
+			fixups[i].node,
+			declaration,
+			parser))
+			return false;
+
+		parser_allocator_node(
+			parser,
+			fixups[i].node)->child1 = declaration;
+	}
+
+	parser->count_fixups = 0;
+	return true;
+}
@@ -0,0 +1,378 @@
+#include <assert.h>
+#include "lexer_def.h"
+#include "parser_allocator.h"
+#include "parser_call.h"
+#include "parser_expression.h"
+#include "parser_utils.h"
+
+/*
+ * Pratt parsing without recursion: the operators waiting for their right operand are kept
+ * on a stack (`Parser.operators`, grown with the nesting), and the nodes are written in the arena in postfix order
+*/
+
+#define POWER_PREFIX 6
+
+static bool is_special(
+const Token* token,
+TokenSubtype subtype) {
+	return token->type == TokenType_SPECIAL
+	    && token->subtype == subtype;
+}
+
+// the lexer marks a key following an operator as an identifier, or as a type after a leveling operator
+static bool is_name(const Token* token) {
+	return parser_is_key(token)
+	    || ((token->type == TokenType_L
+	      || token->type == TokenType_R)
+	     && (token->subtype == TokenSubtype_NO
+	      || token->subtype == TokenSubtype_IDENTIFIER));
+}
+
+static bool is_name_called(const Token* token) {
+	return is_name(token)
+	    && is_special(
+		token + 1,
+		TokenSubtype_LPARENTHESIS);
+}
+
+// the leveling operators, then the arithmetic ones
+static uint8_t binary_power(
+const Token* token,
+NodeSubtypeExpression* subtype) {
+	if(token->type != TokenType_SPECIAL)
+		return 0;
+
+	switch(token->subtype) {
+	case TokenSubtype_PIPE: *subtype = NodeSubtypeExpression_OR; return 1;
+	case TokenSubtype_CARET: *subtype = NodeSubtypeExpression_XOR; return 2;
+	case TokenSubtype_AMPERSAND: *subtype = NodeSubtypeExpression_AND; return 3;
+	case TokenSubtype_PLUS: *subtype = NodeSubtypeExpression_ADD; return 4;
+	case TokenSubtype_MINUS: *subtype = NodeSubtypeExpression_SUBTRACT; return 4;
+	case TokenSubtype_ASTERISK: *subtype = NodeSubtypeExpression_MULTIPLY; return 5;
+	case TokenSubtype_DIVIDE: *subtype = NodeSubtypeExpression_DIVIDE; return 5;
+	case TokenSubtype_MODULO: *subtype = NodeSubtypeExpression_MODULO; return 5;
+	default: return 0;
+	}
+}
+
+// return 0 if the allocation fails
+static uint32_t create_node(
+Node node,
+Parser* parser) {
+	if(!parser_allocator(parser))
+		return 0;
+
+	const uint32_t index = parser_allocator_index(parser);
+	*parser_allocator_node(
+		parser,
+		index) = node;
+	return index;
+}
+
+static bool reduce(
+const ParserExpressionOperator* operator,
+uint32_t* operands,
+size_t* count_operands,
+Parser* parser) {
+	Node node = {
+		.is_child = false,
+		.type = NodeType_EXPRESSION,
+		.subtype = operator->subtype,
+		.token = operator->token};
+
+	if(operator->type == ParserExpressionOperatorType_PREFIX) {
+		assert(*count_operands >= 1);
+		node.child1 = operands[*count_operands - 1];
+		node.child2 = 0;
+		*count_operands -= 1;
+	} else {
+		assert(*count_operands >= 2);
+		node.child1 = operands[*count_operands - 2];
+		node.child2 = operands[*count_operands - 1];
+		*count_operands -= 2;
+	}
+
+	const uint32_t index = create_node(
+		node,
+		parser);
+
+	if(index == 0)
+		return false;
+
+	operands[*count_operands] = index;
+	*count_operands += 1;
+	return true;
+}
+
+// the arguments of a call are chained by `child2`
+static bool add_argument(
+ParserExpressionOperator* call,
+uint32_t* operands,
+size_t* count_operands,
+Parser* parser) {
+	assert(*count_operands == call->count_operands + 1);
+
+	const uint32_t index = create_node(
+		(Node) {
+			.is_child = false,
+			.type = NodeType_EXPRESSION,
+			.subtype = NodeSubtypeExpression_ARGUMENT,
+			.token = 0,
+			.child1 = operands[*count_operands - 1],
+			.child2 = 0},
+		parser);
+
+	if(index == 0)
+		return false;
+
+	if(call->argument_last != 0) {
+		parser_allocator_node(
+			parser,
+			call->argument_last)->child2 = index;
+	} else
+		call->argument_first = index;
+
+	call->argument_last = index;
+	*count_operands -= 1;
+	return true;
+}
+
+// `child1` points to the label called and `child2` to the first argument
+static bool close_call(
+const ParserExpressionOperator* call,
+uint32_t* operands,
+size_t* count_operands,
+Parser* parser) {
+	const uint32_t index = create_node(
+		(Node) {
+			.is_child = false,
+			.type = NodeType_CALL,
+			.subtype = NodeSubtypeCallBitTime_BINARY
+			         | NodeSubtypeCallBitReturnDeduce_TRUE
+			         | NodeSubtypeCallBitArguments_TRUE,
+			.token = call->token,
+			.child1 = 0,
+			.child2 = call->argument_first},
+		parser);
+
+	if(index == 0
+	|| !parser_call_bind(
+		index,
+		parser))
+		return false;
+
+	operands[*count_operands] = index;
+	*count_operands += 1;
+	return true;
+}
+
+/*
+ * the literals, keys, calls of labels, prefix `-` and `~`, and the binary operators
+ * return 0 if the tokens do not make an expression, the nodes created being left to the failed parse
+*/
+int if_expression_create_nodes(
+size_t* i,
+uint32_t* node_expression,
+Parser* parser) {
+	assert(i != NULL);
+	assert(node_expression != NULL);
+	assert(parser != NULL);
+
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	size_t count_operators = 0;
+	size_t count_operands = 0;
+	size_t buffer_i = *i;
+	bool is_operand = true; // expected, else an operator
+
+	while(true) {
+		const Token* token = tokens + buffer_i;
+
+		// room for the operator or the operand pushed by this token
+		if(!parser_allocator_expression(
+			count_operators,
+			count_operands,
+			parser))
+			return -1;
+
+		ParserExpressionOperator* const operators = (ParserExpressionOperator*) parser->operators.addr;
+		uint32_t* const operands = (uint32_t*) parser->operands.addr;
+
+		if(is_operand) {
+			if(token->type == TokenType_LITERAL) {
+				operands[count_operands] = create_node(
+					(Node) {
+						.is_child = false,
+						.type = NodeType_LITERAL,
+						.subtype = (NodeSubtypeLiteral) token->subtype,
+						.token = (uint32_t) buffer_i,
+						.child1 = 0,
+						.child2 = 0},
+					parser);
+
+				if(operands[count_operands] == 0)
+					return -1;
+
+				count_operands += 1;
+				buffer_i += 1;
+				is_operand = false;
+			} else if(is_name_called(token)) {
+				operators[count_operators] = (ParserExpressionOperator) {
+					.type = ParserExpressionOperatorType_CALL,
+					.power = 0,
+					.subtype = NodeSubtypeExpression_NO,
+					.token = (uint32_t) buffer_i,
+					.argument_first = 0,
+					.argument_last = 0,
+					.count_operands = count_operands};
+				count_operators += 1;
+				buffer_i += 2;
+			} else if(is_name(token)) {
+				operands[count_operands] = create_node(
+					(Node) {
+						.is_child = false,
+						.type = NodeType_EXPRESSION,
+						.subtype = NodeSubtypeExpression_KEY,
+						.token = (uint32_t) buffer_i,
+						.child1 = 0,
+						.child2 = 0},
+					parser);
+
+				if(operands[count_operands] == 0
+				|| !parser_call_bind(
+					operands[count_operands],
+					parser))
+					return -1;
+
+				count_operands += 1;
+				buffer_i += 1;
+				is_operand = false;
+			} else if(is_special(
+				token,
+				TokenSubtype_LPARENTHESIS)) {
+				operators[count_operators] = (ParserExpressionOperator) {
+					.type = ParserExpressionOperatorType_PARENTHESIS,
+					.power = 0,
+					.subtype = NodeSubtypeExpression_NO,
+					.token = (uint32_t) buffer_i,
+					.count_operands = count_operands};
+				count_operators += 1;
+				buffer_i += 1;
+			} else if(is_special(
+				token,
+				TokenSubtype_MINUS)
+			       || is_special(
+				token,
+				TokenSubtype_TILDE)) {
+				operators[count_operators] = (ParserExpressionOperator) {
+					.type = ParserExpressionOperatorType_PREFIX,
+					.power = POWER_PREFIX,
+					.subtype = token->subtype == TokenSubtype_MINUS
+					         ? NodeSubtypeExpression_NEGATE
+					         : NodeSubtypeExpression_NOT,
+					.token = (uint32_t) buffer_i,
+					.count_operands = count_operands};
+				count_operators += 1;
+				buffer_i += 1;
+			} else if(is_special(
+				token,
+				TokenSubtype_RPARENTHESIS)
+			       && count_operators != 0
+			       && operators[count_operators - 1].type == ParserExpressionOperatorType_CALL
+			       && operators[count_operators - 1].argument_first == 0) {
+				// a call without argument, like in `lab()`
+				count_operators -= 1;
+
+				if(!close_call(
+					operators + count_operators,
+					operands,
+					&count_operands,
+					parser))
+					return -1;
+
+				buffer_i += 1;
+				is_operand = false;
+			} else
+				return 0;
+
+			continue;
+		}
+
+		NodeSubtypeExpression subtype = NodeSubtypeExpression_NO;
+		const uint8_t power = binary_power(
+			token,
+			&subtype);
+		// left associative, the operators of the same power are reduced first
+		while(count_operators != 0
+		   && operators[count_operators - 1].power != 0
+		   && operators[count_operators - 1].power >= (power != 0 ? power : 1)) {
+			count_operators -= 1;
+
+			if(!reduce(
+				operators + count_operators,
+				operands,
+				&count_operands,
+				parser))
+				return -1;
+		}
+
+		if(power != 0) {
+			operators[count_operators] = (ParserExpressionOperator) {
+				.type = ParserExpressionOperatorType_BINARY,
+				.power = power,
+				.subtype = subtype,
+				.token = (uint32_t) buffer_i,
+				.count_operands = count_operands};
+			count_operators += 1;
+			buffer_i += 1;
+			is_operand = true;
+			continue;
+		}
+		// any other token ends the expression, the caller checks it
+		if(count_operators == 0)
+			break;
+
+		ParserExpressionOperator* operator = operators + count_operators - 1;
+
+		if(is_special(
+			token,
+			TokenSubtype_COMMA)
+		&& operator->type == ParserExpressionOperatorType_CALL) {
+			if(!add_argument(
+				operator,
+				operands,
+				&count_operands,
+				parser))
+				return -1;
+
+			buffer_i += 1;
+			is_operand = true;
+		} else if(is_special(
+			token,
+			TokenSubtype_RPARENTHESIS)) {
+			count_operators -= 1;
+
+			if(operator->type == ParserExpressionOperatorType_CALL
+			&& (!add_argument(
+				operator,
+				operands,
+				&count_operands,
+				parser)
+			 || !close_call(
+				operator,
+				operands,
+				&count_operands,
+				parser)))
+				return -1;
+
+			buffer_i += 1;
+		} else
+			return 0; // a parenthesis is not closed
+	}
+
+	assert(count_operands == 1);
+	*node_expression = ((const uint32_t*) parser->operands.addr)[0];
+	*i = buffer_i;
+	return 1;
+}
+
+#undef POWER_PREFIX
@@ -2,7 +2,9 @@
 #include <stddef.h>
 #include "lexer_def.h"
 #include "parser_allocator.h"
+#include "parser_expression.h"
 #include "parser_identifier.h"
+#include "parser_qualifier.h"
 #include "parser_type.h"
 #include "parser_utils.h"
 #include <stdio.h>
@@ -18,24 +20,16 @@ static NodeSubtypeIdentificationBitCommand token_subtype_command_to_subtype(Toke
 	}
 }
 
-static NodeSubtypeLiteral token_subtype_literal_to_subtype(TokenSubtype subtype_token) {
-	return (NodeSubtypeLiteral) subtype_token;
-}
-
 int if_declaration_create_nodes(
 size_t* i,
-MemoryArea* restrict memArea,
-Node** node_identification,
+uint32_t* node_identification,
 Parser* parser) {
 	assert(i != NULL);
 	assert(parser != NULL);
 
 	size_t buffer_i = *i;
-	size_t i_qualifier = buffer_i;
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
 	NodeSubtype subtype = NodeSubtype_NO;
-	MemoryChainState memChain_state;
-	initialize_memory_chain_state(&memChain_state);
 
 	while(parser_is_qualifier(tokens + buffer_i)) buffer_i += 1;
 
@@ -48,55 +42,40 @@ Parser* parser) {
 	if(tokens[buffer_i].subtype != TokenSubtype_IDENTIFIER)
 		return 0;
 
-	memory_chain_state_save(
-		&parser->nodes,
-		&memChain_state);
-
 	if(!parser_allocator(parser))
 		return -1;
 
-	*((Node*) parser->nodes.top) = (Node) {
+	const uint32_t index = parser_allocator_index(parser);
+	*parser_allocator_node(
+		parser,
+		index) = (Node) {
 		.is_child = false,
 		.type = NodeType_IDENTIFICATION,
 		.subtype = subtype,
-		.token = tokens + buffer_i,
-		.child1 = NULL,
-		.child2 = NULL};
+		.token = (uint32_t) buffer_i,
+		.child1 = 0,
+		.child2 = 0};
 	buffer_i += 1;
 
 	if(node_identification != NULL)
-		*node_identification = (Node*) parser->nodes.top;
-
-	while(parser_is_qualifier(tokens + i_qualifier)) {
-		if(!parser_allocator(parser))
-			return -1;
-
-		*((Node*) parser->nodes.top) = (Node) {
-			.is_child = true,
-			.type = NodeType_QUALIFIER,
-			.subtype = tokens[i_qualifier].subtype,
-			.token = tokens + i_qualifier,
-			.child1 = NULL,
-			.child2 = NULL};
-		((Node*) parser->nodes.previous)->child1 = (Node*) parser->nodes.top;
-		i_qualifier += 1;
-	}
+		*node_identification = index;
+
+	if(!parser_qualifier_add(
+		index,
+		parser))
+		return -1;
 	// type deduction later
 	NodeSubtypeIdentificationBitScoped bit_scoped;
 	switch(if_type_create_nodes(
 		&buffer_i,
-		memArea,
 		&bit_scoped,
 		parser)) {
 	case -1: return -1;
-	case 0:
-		memory_chain_state_restore(
-			&parser->nodes,
-			&memChain_state);
-		return 0;
+	case 0: return 0; // the parse stops, nothing to roll back
 	case 1:
-		if(node_identification != NULL)
-			(*node_identification)->subtype |= bit_scoped;
+		parser_allocator_node(
+			parser,
+			index)->subtype |= bit_scoped;
 		break;
 	}
 	
@@ -106,49 +85,39 @@ Parser* parser) {
 
 static int if_initialization_create_node(
 size_t* i,
-Node* node_identification,
+uint32_t node_identification,
 Parser* parser) {
-	// just parse literals for the moment, expressions later
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
 	size_t buffer_i = *i;
 
 	if(parser_is_scope_L(tokens + buffer_i))
 		return 1; // `.child2` determined in the loop of `create_parser`
+	// declaration case, known before creating an expression
+	if(tokens[buffer_i].subtype == TokenSubtype_SEMICOLON
+	|| tokens[buffer_i].subtype == TokenSubtype_PERIOD)
+		return 0;
 
-	MemoryChainState memChain_state;
-	initialize_memory_chain_state(&memChain_state);
-	memory_chain_state_save(
-		&parser->nodes,
-		&memChain_state);
+	uint32_t node_expression;
 
-	if(!parser_allocator(parser))
+	if(if_expression_create_nodes(
+		&buffer_i,
+		&node_expression,
+		parser)
+	!= 1)
 		return -1;
 
-	if(tokens[buffer_i].type == TokenType_LITERAL) {
-		*((Node*) parser->nodes.top) = (Node) {
-			.type = NodeType_LITERAL,
-			.subtype = token_subtype_literal_to_subtype(tokens[buffer_i].subtype),
-			.token = tokens + buffer_i};
-		buffer_i += 1;
-	} else {
-		memory_chain_state_restore(
-			&parser->nodes,
-			&memChain_state);
-		return 0;
-	}
-
-	node_identification->child2 = (Node*) parser->nodes.top;
+	parser_allocator_node(
+		parser,
+		node_identification)->child2 = node_expression;
 	*i = buffer_i;
 	return 1;
 }
 
 int if_identification_create_nodes(
 size_t* i,
-MemoryArea* restrict memArea,
-Node** node_identification,
+uint32_t* node_identification,
 Parser* parser) {
 	assert(i != NULL);
-	assert(memArea != NULL);
 	assert(node_identification != NULL);
 	assert(parser != NULL);
 
@@ -156,19 +125,13 @@ Parser* parser) {
 
 	switch(if_declaration_create_nodes(
 		&buffer_i,
-		memArea,
 		node_identification,
 		parser)) {
 	case -1: return -1;
 	case 0: return 0;
 	}
 	// add the type as child nodes in `.child1`
-	
-	MemoryChainState memChain_state;
-	initialize_memory_chain_state(&memChain_state);
-	memory_chain_state_save(
-		&parser->nodes,
-		&memChain_state);
+	NodeSubtypeIdentificationBitType bit_type;
 
 	switch(if_initialization_create_node(
 		&buffer_i,
@@ -176,16 +139,16 @@ Parser* parser) {
 		parser)) {
 	case -1: return -1;
 	case 0: // declaration case
-		memory_chain_state_restore(
-			&parser->nodes,
-			&memChain_state);
-		(*node_identification)->subtype |= NodeSubtypeIdentificationBitType_DECLARATION;
+		bit_type = NodeSubtypeIdentificationBitType_DECLARATION;
 		break;
 	case 1: // initialization case
-		(*node_identification)->subtype |= NodeSubtypeIdentificationBitType_INITIALIZATION;
+		bit_type = NodeSubtypeIdentificationBitType_INITIALIZATION;
 		break;
 	}
 
+	parser_allocator_node(
+		parser,
+		*node_identification)->subtype |= bit_type;
 	*i = buffer_i;
 	return 1;
 }
@@ -0,0 +1,437 @@
+#include <assert.h>
+#include <string.h>
+#include "parser.h"
+#include "parser_allocator.h"
+#include "parser_call.h"
+#include "parser_incremental.h"
+#include "parser_qualifier.h"
+#include "parser_signature.h"
+#include "parser_symbol.h"
+#include "parser_type_table.h"
+
+/*
+ * the instructions at file scope (`Parser.tops`) of the previous parse are either copied or parsed again
+ * an instruction is parsed again if an edit touches its tokens, if it shares a type with one parsed again,
+ * or if a type it owns is now known before it,
+ * the names it refers to outside of itself are looked up again
+*/
+
+#define SEGMENT_DIRTY UINT32_MAX
+
+typedef struct {
+	const Parser* previous;
+	const ParserTop* tops;
+	size_t end_old; // the last token of the previous lexing, excluded
+	uint32_t* starts; // first node in the parser of each copied instruction, or `SEGMENT_DIRTY`
+} Incremental;
+
+static size_t segment_end_token(
+const Incremental* incremental,
+size_t k) {
+	return k + 1 < incremental->previous->count_tops ? incremental->tops[k + 1].token : incremental->end_old;
+}
+
+static uint32_t segment_end_node(
+const Incremental* incremental,
+size_t k) {
+	return k + 1 < incremental->previous->count_tops
+	     ? incremental->tops[k + 1].node
+	     : (uint32_t) incremental->previous->count_nodes;
+}
+
+// the instruction holding a node of the previous parse
+static size_t segment_find(
+const Incremental* incremental,
+uint32_t node) {
+	size_t low = 0;
+	size_t high = incremental->previous->count_tops;
+
+	while(high - low > 1) {
+		const size_t middle = low + (high - low) / 2;
+
+		if(incremental->tops[middle].node <= node)
+			low = middle;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+// `child1` of a key or of a call is looked up again by name
+static bool is_named(const Node* node) {
+	return node->is_child == false
+	    && (node->type == NodeType_CALL
+	     || (node->type == NodeType_EXPRESSION
+	      && node->subtype == NodeSubtypeExpression_KEY));
+}
+
+// a node out of the instruction (a shared type) must be in a copied instruction
+static bool is_reusable(
+const Incremental* incremental,
+size_t k) {
+	const Node* nodes = (const Node*) incremental->previous->nodes.addr;
+	const uint32_t node_start = incremental->tops[k].node;
+	const uint32_t node_end = segment_end_node(
+		incremental,
+		k);
+
+	for(uint32_t i = node_start;
+	i < node_end;
+	i += 1) {
+		// `child1` of a key or of a call is not followed
+		const uint32_t children[2] = {is_named(nodes + i) ? 0 : nodes[i].child1, nodes[i].child2};
+
+		for(size_t j = 0;
+		j < 2;
+		j += 1) {
+			if(children[j] == 0
+			|| (children[j] >= node_start
+			 && children[j] < node_end))
+				continue;
+
+			const size_t segment = segment_find(
+				incremental,
+				children[j]);
+
+			if(segment >= k
+			|| incremental->starts[segment] == SEGMENT_DIRTY)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static uint32_t relocate(
+const Incremental* incremental,
+uint32_t node,
+uint32_t node_start,
+uint32_t node_end,
+uint32_t start) {
+	if(node == 0)
+		return 0;
+
+	if(node >= node_start
+	&& node < node_end)
+		return node - node_start + start;
+
+	const size_t segment = segment_find(
+		incremental,
+		node);
+	return node - incremental->tops[segment].node + incremental->starts[segment];
+}
+
+/*
+ * the nodes of an unchanged instruction moved after the ones of the parser
+ * return 0 if it must be parsed again, a type it owns being now known before it
+*/
+static int copy_segment(
+Incremental* incremental,
+size_t k,
+size_t token_start,
+size_t* symbol,
+Parser* parser) {
+	const Parser* previous = incremental->previous;
+	const uint32_t node_start = incremental->tops[k].node;
+	const uint32_t node_end = segment_end_node(
+		incremental,
+		k);
+	const uint32_t count_nodes = node_end - node_start;
+	const uint32_t start = (uint32_t) parser->count_nodes;
+	const uint32_t token_offset = (uint32_t) token_start - incremental->tops[k].token;
+
+	if(!parser_allocator_top(parser)
+	|| !parser_allocator_reserve(
+		count_nodes,
+		parser))
+		return -1;
+
+	((ParserTop*) parser->tops.addr)[parser->count_tops] = (ParserTop) {
+		.token = (uint32_t) token_start,
+		.node = start};
+	parser->count_tops += 1;
+
+	Node* nodes = (Node*) parser->nodes.addr + start;
+	memcpy(
+		nodes,
+		(const Node*) previous->nodes.addr + node_start,
+		count_nodes * sizeof(Node));
+	parser->count_nodes += count_nodes;
+
+	for(uint32_t i = 0;
+	i < count_nodes;
+	i += 1) {
+		// the unsigned sum wraps around if the tokens moved backward
+		if(nodes[i].token != 0
+		&& (nodes[i].is_child
+		 || nodes[i].type != NodeType_SCOPE_START))
+			nodes[i].token += token_offset;
+
+		nodes[i].child2 = relocate(
+			incremental,
+			nodes[i].child2,
+			node_start,
+			node_end,
+			start);
+
+		if(is_named(nodes + i)
+		&& (nodes[i].child1 < node_start
+		 || nodes[i].child1 >= node_end)) {
+			nodes[i].child1 = 0;
+			continue;
+		}
+
+		nodes[i].child1 = relocate(
+			incremental,
+			nodes[i].child1,
+			node_start,
+			node_end,
+			start);
+	}
+	// its parse would share the type, so the copy is dropped before anything refers to it
+	for(uint32_t i = 0;
+	i < count_nodes;
+	i += 1) {
+		if(nodes[i].is_child
+		|| nodes[i].type != NodeType_IDENTIFICATION
+		|| nodes[i].child1 < start
+		|| parser_type_find(
+			nodes[i].child1,
+			parser)
+		== 0)
+			continue;
+
+		parser->count_nodes = start;
+		parser->count_tops -= 1;
+		return 0;
+	}
+	// before the symbols of the instruction, as when it was parsed
+	for(uint32_t i = start;
+	i < start + count_nodes;
+	i += 1) {
+		Node* node = parser_allocator_node(
+			parser,
+			i);
+
+		if(!is_named(node)
+		|| node->child1 != 0)
+			continue;
+
+		if(node->type == NodeType_CALL) {
+			if(!parser_call_bind(
+				i,
+				parser))
+				return -1;
+		} else {
+			node->child1 = parser_symbol_find(
+				parser_symbol_name(
+					parser->lexer,
+					(const Token*) parser->lexer->tokens.addr + node->token),
+				&parser->symbols);
+		}
+	}
+
+	const ParserSymbol* symbols = (const ParserSymbol*) previous->symbols.symbols.addr;
+
+	for(;
+	*symbol < previous->symbols.count_symbols
+	&& symbols[*symbol].node < node_end;
+	*symbol += 1) {
+		if(symbols[*symbol].node < node_start)
+			continue;
+
+		const uint32_t node = symbols[*symbol].node - node_start + start;
+
+		if(parser_symbol_add(
+			parser_symbol_name(
+				parser->lexer,
+				(const Token*) parser->lexer->tokens.addr + parser_allocator_node(
+					parser,
+					node)->token),
+			node,
+			&parser->symbols)
+		== false)
+			return -1;
+	}
+
+	for(uint32_t i = start;
+	i < start + count_nodes;
+	i += 1) {
+		if(!parser_signature_add(
+			i,
+			parser))
+			return -1;
+	}
+	// the types owned by the instruction can be shared by the next ones
+	for(uint32_t i = start;
+	i < start + count_nodes;
+	i += 1) {
+		const Node* node = parser_allocator_node(
+			parser,
+			i);
+
+		if(node->is_child
+		|| node->type != NodeType_IDENTIFICATION)
+			continue;
+
+		if(((node->subtype & NodeSubtypeIdentificationBitQualifier_CUSTOM)
+		 && !parser_qualifier_add(
+			i,
+			parser))
+		|| (node->child1 >= start
+		 && parser_type_intern(
+			node->child1,
+			parser)
+		== 0))
+			return -1;
+	}
+
+	incremental->starts[k] = start;
+	return 1;
+}
+
+// the instructions between two copied ones must end at file scope
+static bool parse_segments(
+size_t start,
+size_t end,
+Parser* parser) {
+	return start >= end
+	    || (parser_parse_tokens(
+		start,
+		end,
+		parser)
+	     && parser->count_scopes == 0);
+}
+
+/*
+ * return 0 if the previous parse cannot be used, the parser being untouched
+ * the calls still to be resolved are left in `Parser.fixups`
+*/
+int parser_incremental_create(
+const Parser* previous,
+const ParserEdit* edits,
+size_t count_edits,
+Parser* parser) {
+	assert(previous != NULL);
+	assert(edits != NULL || count_edits == 0);
+	assert(parser != NULL);
+
+	const size_t end_new = parser->lexer->tokens.count - 1;
+	// a previous parse loaded from the AST file has no instructions
+	if(previous->count_tops == 0
+	|| previous->count_scopes != 0
+	|| previous->count_fixups != 0)
+		return 0;
+	// the edits are ordered and do not overlap
+	size_t end_old = end_new;
+
+	for(size_t i = 0;
+	i < count_edits;
+	i += 1) {
+		if(edits[i].end_old < edits[i].start
+		|| edits[i].end_new < edits[i].start
+		|| (i != 0
+		 && edits[i].start < edits[i - 1].end_old))
+			return 0;
+
+		end_old = end_old + edits[i].end_old - edits[i].end_new;
+	}
+
+	if(count_edits != 0
+	&& edits[count_edits - 1].end_old > end_old)
+		return 0;
+
+	MemoryArea starts;
+	initialize_memory_area(&starts);
+	Incremental incremental = {
+		.previous = previous,
+		.tops = (const ParserTop*) previous->tops.addr,
+		.end_old = end_old};
+	int status = -1;
+
+	if(create_memory_area(
+		previous->count_tops,
+		sizeof(uint32_t),
+		&starts)
+	== false
+	|| !parser_create_allocators(parser))
+		goto DESTROY;
+
+	incremental.starts = (uint32_t*) starts.addr;
+	size_t edit = 0;
+	size_t token_offset = 0; // added by the edits before the instruction, wraps around if negative
+	size_t symbol = 0;
+	bool is_dirty = false;
+	size_t dirty_start = 0;
+
+	for(size_t k = 0;
+	k < previous->count_tops;
+	k += 1) {
+		const size_t token_start = incremental.tops[k].token;
+
+		while(edit < count_edits
+		   && edits[edit].end_old < token_start) {
+			token_offset += edits[edit].end_new - edits[edit].end_old;
+			edit += 1;
+		}
+
+		if((edit < count_edits
+		 && edits[edit].start <= segment_end_token(
+			&incremental,
+			k))
+		|| !is_reusable(
+			&incremental,
+			k)) {
+			if(!is_dirty)
+				dirty_start = token_start + token_offset;
+
+			incremental.starts[k] = SEGMENT_DIRTY;
+			is_dirty = true;
+			continue;
+		}
+
+		if(is_dirty
+		&& !parse_segments(
+			dirty_start,
+			token_start + token_offset,
+			parser)) {
+			status = 0;
+			goto DESTROY;
+		}
+
+		is_dirty = false;
+
+		switch(copy_segment(
+			&incremental,
+			k,
+			token_start + token_offset,
+			&symbol,
+			parser)) {
+		case -1: goto DESTROY;
+		case 0:
+			dirty_start = token_start + token_offset;
+			incremental.starts[k] = SEGMENT_DIRTY;
+			is_dirty = true;
+		}
+	}
+
+	if(is_dirty
+	&& !parse_segments(
+		dirty_start,
+		end_new,
+		parser)) {
+		status = 0;
+		goto DESTROY;
+	}
+
+	destroy_memory_area(&starts);
+	return 1;
+DESTROY:
+	destroy_memory_area(&starts);
+	parser_destroy_allocators(parser);
+	parser_initialize_allocators(parser);
+	return status;
+}
+
+#undef SEGMENT_DIRTY
@@ -0,0 +1,358 @@
+#include <assert.h>
+#include "parser.h"
+#include "parser_allocator.h"
+#include "parser_linear.h"
+
+/*
+ * depth-first walk without recursion, the subtrees waiting to be walked are kept on a stack
+ * the instructions of a scope are not linked to each other: they follow in `Parser.nodes`,
+ * so the next one starts after the last node reached by the walk
+*/
+
+#define CHUNK_LINEAR 256
+#define CHUNK_STACK 64
+#define PREFETCH_DISTANCE 8 // entries ahead whose token is fetched
+
+typedef enum: uint8_t {
+#define LINEAR_ITEM(type) LinearItem_ ## type
+	LINEAR_ITEM(VISIT), // a node and its subtree
+	LINEAR_ITEM(CLOSE), // the size of an entry once its subtree is added
+	LINEAR_ITEM(SEQUENCE), // the instructions up to a node, excluded
+#undef LINEAR_ITEM
+} LinearItem;
+
+typedef struct {
+	LinearItem type;
+	uint32_t value; // node, entry or end of the instructions
+} LinearStackItem;
+
+void parser_initialize_linear(ParserLinear* linear) {
+	assert(linear != NULL);
+
+	initialize_memory_area(&linear->nodes);
+	linear->count_nodes = 0;
+}
+
+void parser_destroy_linear(ParserLinear* linear) {
+	if(linear == NULL)
+		return;
+
+	destroy_memory_area(&linear->nodes);
+	parser_initialize_linear(linear);
+}
+
+static bool push(
+LinearItem type,
+uint32_t value,
+MemoryArea* stack,
+size_t* count_stack) {
+	if(*count_stack == stack->count
+	&& !memory_area_realloc(
+		stack->count * 2,
+		stack))
+		return false;
+
+	((LinearStackItem*) stack->addr)[*count_stack] = (LinearStackItem) {
+		.type = type,
+		.value = value};
+	*count_stack += 1;
+	return true;
+}
+
+// pushed in reverse order, so walked from `child1` to `child2`
+static bool push_children(
+const Node* node,
+MemoryArea* stack,
+size_t* count_stack) {
+	uint32_t children[2] = {0, 0};
+
+	if(node->is_child) {
+		// next link of a type or of a module
+		children[0] = node->child1;
+	} else {
+		switch(node->type) {
+		case NodeType_MODULE:
+			children[0] = node->child;
+			break;
+		case NodeType_SCOPE_START:
+			// the end is 0 while the scope is not closed
+			if(node->child != 0
+			&& !push(
+				LinearItem_VISIT,
+				node->child,
+				stack,
+				count_stack))
+				return false;
+
+			return push(
+				LinearItem_SEQUENCE,
+				node->child,
+				stack,
+				count_stack);
+		case NodeType_IDENTIFICATION:
+			children[0] = node->child1;
+			children[1] = node->child2;
+			break;
+		case NodeType_CALL:
+			// `child1` is the label called
+			children[0] = node->child2;
+			break;
+		case NodeType_EXPRESSION:
+			// `child1` of a key is its identification
+			if(node->subtype != NodeSubtypeExpression_KEY) {
+				children[0] = node->child1;
+				children[1] = node->child2;
+			} break;
+		}
+	}
+
+	for(size_t i = 2;
+	i > 0;
+	i -= 1) {
+		if(children[i - 1] != 0
+		&& !push(
+			LinearItem_VISIT,
+			children[i - 1],
+			stack,
+			count_stack))
+			return false;
+	}
+
+	return true;
+}
+
+static bool add_entry(
+uint32_t id,
+const Parser* parser,
+ParserLinear* linear) {
+	if(linear->count_nodes == linear->nodes.count
+	&& !memory_area_realloc(
+		linear->nodes.count * 2,
+		&linear->nodes))
+		return false;
+
+	((ParserLinearNode*) linear->nodes.addr)[linear->count_nodes] = (ParserLinearNode) {
+		.node = *parser_allocator_node(
+			parser,
+			id),
+		.id = id,
+		.size = 1};
+	linear->count_nodes += 1;
+	return true;
+}
+
+/*
+ * flatten the nodes of a finished parse in pre-order with the sizes of the subtrees,
+ * so a pass reads them in one direction and skips a subtree by its size
+*/
+bool parser_create_linear(
+const Parser* parser,
+ParserLinear* linear) {
+	assert(parser != NULL);
+	assert(linear != NULL);
+
+	MemoryArea stack;
+	initialize_memory_area(&stack);
+	size_t count_stack = 0;
+	// the last node of `Parser.nodes` walked, the next instruction follows it
+	uint32_t reach = 0;
+
+	if(create_memory_area(
+		CHUNK_LINEAR,
+		sizeof(ParserLinearNode),
+		&linear->nodes)
+	== false
+	|| create_memory_area(
+		CHUNK_STACK,
+		sizeof(LinearStackItem),
+		&stack)
+	== false
+	|| !push(
+		LinearItem_SEQUENCE,
+		(uint32_t) parser->count_nodes,
+		&stack,
+		&count_stack))
+		goto DESTROY;
+
+	linear->count_nodes = 0;
+
+	while(count_stack != 0) {
+		count_stack -= 1;
+		const LinearStackItem item = ((const LinearStackItem*) stack.addr)[count_stack];
+
+		switch(item.type) {
+		case LinearItem_VISIT:
+			if(item.value > reach)
+				reach = item.value;
+
+			if(!add_entry(
+				item.value,
+				parser,
+				linear)
+			|| !push(
+				LinearItem_CLOSE,
+				(uint32_t) linear->count_nodes - 1,
+				&stack,
+				&count_stack)
+			|| !push_children(
+				parser_allocator_node(
+					parser,
+					item.value),
+				&stack,
+				&count_stack))
+				goto DESTROY;
+
+			break;
+		case LinearItem_CLOSE:
+			((ParserLinearNode*) linear->nodes.addr)[item.value].size = (uint32_t) linear->count_nodes - item.value;
+			break;
+		case LinearItem_SEQUENCE:
+			// the sequence goes on after the instruction
+			if(reach + 1 < item.value
+			&& (!push(
+				LinearItem_SEQUENCE,
+				item.value,
+				&stack,
+				&count_stack)
+			 || !push(
+				LinearItem_VISIT,
+				reach + 1,
+				&stack,
+				&count_stack)))
+				goto DESTROY;
+
+			break;
+		}
+	}
+
+	destroy_memory_area(&stack);
+	return true;
+DESTROY:
+	destroy_memory_area(&stack);
+	parser_destroy_linear(linear);
+	return false;
+}
+
+static ParserVisitCallback callback_pre(
+const ParserVisitor* visitor,
+const Node* node) {
+	return node->is_child ? visitor->pre_link : visitor->pre[node->type];
+}
+
+static ParserVisitCallback callback_post(
+const ParserVisitor* visitor,
+const Node* node) {
+	return node->is_child ? visitor->post_link : visitor->post[node->type];
+}
+
+/*
+ * call the callbacks of `visitor` in the order of the code, the post callback of a node after its subtree
+ * the entries being read in order, only their tokens are fetched ahead
+ * return 0 if a callback stops the walk, -1 if an allocation fails
+*/
+int parser_visit(
+const Parser* parser,
+const ParserLinear* linear,
+const ParserVisitor* visitor,
+void* data) {
+	assert(parser != NULL);
+	assert(linear != NULL);
+	assert(visitor != NULL);
+
+	const ParserLinearNode* entries = (const ParserLinearNode*) linear->nodes.addr;
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	// the entries whose subtree is being visited
+	MemoryArea open;
+	size_t count_open = 0;
+	int status = 1;
+
+	if(create_memory_area(
+		CHUNK_STACK,
+		sizeof(uint32_t),
+		&open)
+	== false)
+		return -1;
+
+	for(size_t i = 0;
+	i < linear->count_nodes;) {
+		// the start of a scope holds a count in place of its token, the address is not read
+		if(i + PREFETCH_DISTANCE < linear->count_nodes)
+			__builtin_prefetch(tokens + entries[i + PREFETCH_DISTANCE].node.token);
+
+		while(count_open != 0) {
+			const ParserLinearNode* parent = entries + ((const uint32_t*) open.addr)[count_open - 1];
+
+			if((size_t) (parent - entries) + parent->size > i)
+				break;
+
+			count_open -= 1;
+			const ParserVisitCallback post = callback_post(
+				visitor,
+				&parent->node);
+
+			if(post != NULL
+			&& post(
+				parent,
+				count_open,
+				data)
+			== ParserVisit_STOP) {
+				status = 0;
+				goto END;
+			}
+		}
+
+		const ParserVisitCallback pre = callback_pre(
+			visitor,
+			&entries[i].node);
+
+		switch(pre != NULL ? pre(
+			entries + i,
+			count_open,
+			data) : ParserVisit_CONTINUE) {
+		case ParserVisit_CONTINUE:
+			if(count_open == open.count
+			&& !memory_area_realloc(
+				open.count * 2,
+				&open)) {
+				status = -1;
+				goto END;
+			}
+
+			((uint32_t*) open.addr)[count_open] = (uint32_t) i;
+			count_open += 1;
+			i += 1;
+			break;
+		case ParserVisit_SKIP:
+			i += entries[i].size;
+			break;
+		case ParserVisit_STOP:
+			status = 0;
+			goto END;
+		}
+	}
+	// the last subtrees end with the array
+	while(count_open != 0) {
+		count_open -= 1;
+		const ParserLinearNode* parent = entries + ((const uint32_t*) open.addr)[count_open];
+		const ParserVisitCallback post = callback_post(
+			visitor,
+			&parent->node);
+
+		if(post != NULL
+		&& post(
+			parent,
+			count_open,
+			data)
+		== ParserVisit_STOP) {
+			status = 0;
+			break;
+		}
+	}
+END:
+	destroy_memory_area(&open);
+	return status;
+}
+
+#undef PREFETCH_DISTANCE
+#undef CHUNK_STACK
+#undef CHUNK_LINEAR
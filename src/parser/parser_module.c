@@ -1,6 +1,7 @@
 #include <assert.h>
 #include "parser_allocator.h"
 #include "parser_module.h"
+#include "parser_utils.h"
 
 static int module_bind_child_module(
 size_t i,
@@ -13,13 +14,18 @@ Parser* parser) {
 	if(!parser_allocator(parser))
 		return -1;
 
-	Node* previous = (Node*) parser->nodes.previous;
-	*((Node*) parser->nodes.top) = (Node) {
+	const uint32_t index = parser_allocator_index(parser);
+	Node* previous = parser_allocator_node(
+		parser,
+		index - 1);
+	*parser_allocator_node(
+		parser,
+		index) = (Node) {
 		.is_child = true,
 		.type = NodeType_MODULE,
 		.subtype = previous->subtype,
-		.token = token};
-	previous->child = (Node*) parser->nodes.top;
+		.token = (uint32_t) i};
+	previous->child = index;
 	return 1;
 }
 
@@ -32,9 +38,11 @@ Parser* parser) {
 	size_t buffer_i = *i;
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
 
-	if(tokens[buffer_i].subtype != TokenSubtype_MODULE_INPUT
-	&& tokens[buffer_i].subtype != TokenSubtype_MODULE_OUTPUT)
-		return 0;
+	// followed by a name
+	assert(parser_lookahead(
+		buffer_i,
+		parser)
+	== ParserConstruct_MODULE);
 
 	NodeSubtypeModule subtype;
 
@@ -45,40 +53,28 @@ Parser* parser) {
 
 	buffer_i += 1;
 
-	if(tokens[buffer_i].type != TokenType_L)
-		return 0;
-
-	MemoryChainState memChain_state;
-	initialize_memory_chain_state(&memChain_state);
-	memory_chain_state_save(
-		&parser->nodes,
-		&memChain_state);
-
 	do {
 		if(!parser_allocator(parser))
 			return -1;
 	
-		*((Node*) parser->nodes.top) = (Node) {
+		*parser_allocator_node(
+			parser,
+			parser_allocator_index(parser)) = (Node) {
 			.is_child = false,
 			.type = NodeType_MODULE,
 			.subtype = subtype,
-			.token = tokens + buffer_i,
-			.child = NULL};
+			.token = (uint32_t) buffer_i,
+			.child = 0};
 		buffer_i += 1;
-		int error;
+		int status;
 
-		while((error = module_bind_child_module(
+		while((status = module_bind_child_module(
 			buffer_i,
 			parser))
-		== 1) {
-			switch(error) {
-			case -1: return -1;
-			case 0: goto RETURN_0;
-			case 1: /* fall through */;
-			}
+		== 1) buffer_i += 1;
 
-			buffer_i += 1;
-		}
+		if(status == -1)
+			return -1;
 
 		if(tokens[buffer_i].subtype != TokenSubtype_COMMA)
 			break;
@@ -88,9 +84,4 @@ Parser* parser) {
 
 	*i = buffer_i;
 	return 1;
-RETURN_0:
-	memory_chain_state_restore(
-		&parser->nodes,
-		&memChain_state);
-	return 0;
 }
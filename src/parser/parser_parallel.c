@@ -0,0 +1,393 @@
+#define _POSIX_C_SOURCE 200809L
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "parser.h"
+#include "parser_allocator.h"
+#include "parser_call.h"
+#include "parser_parallel.h"
+#include "parser_qualifier.h"
+#include "parser_signature.h"
+#include "parser_symbol.h"
+#include "parser_type_table.h"
+#include "parser_utils.h"
+
+/*
+ * a large file is cut in units at the end of instructions outside of any scope,
+ * each unit is parsed by a thread in its own parser, then the units are appended in the order of the file:
+ * - the nodes of a unit are moved after the nodes of the previous units, its types being shared with them
+ * - a call not resolved in its unit gets the label identified in a previous unit, like in a single pass,
+ *   or waits for the end of the file
+ * - the symbols of a unit are added after the ones of the previous units
+ * an instruction only depends on the previous one when it starts with a scope, so no cut is made there.
+*/
+
+#ifndef PARSER_PARALLEL_THREADS
+#define PARSER_PARALLEL_THREADS 0 // the number of online processors
+#endif
+#ifndef PARSER_PARALLEL_MIN_TOKENS
+#define PARSER_PARALLEL_MIN_TOKENS 65536 // per unit
+#endif
+#define COUNT_UNIT_MAX 64
+
+typedef struct {
+	size_t start; // index of the first token
+	size_t end;
+	Parser parser;
+	pthread_t thread;
+	bool is_thread;
+	bool status;
+} ParserUnit;
+
+static size_t count_threads(void) {
+	if(PARSER_PARALLEL_THREADS != 0)
+		return PARSER_PARALLEL_THREADS;
+
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (size_t) count : 1;
+}
+// cut the tokens in at most `count_units` units of about the same size, return their count
+static size_t split_units(
+const Lexer* lexer,
+size_t count_units,
+ParserUnit* units) {
+	const Token* tokens = (const Token*) lexer->tokens.addr;
+	const size_t end = lexer->tokens.count - 1;
+	const size_t size_unit = (end - 1) / count_units + 1;
+	size_t depth = 0;
+	size_t start = 1;
+	size_t count = 0;
+
+	for(size_t i = 1;
+	i < end
+	&& count + 1 < count_units;
+	i += 1) {
+		if(parser_is_scope_L(tokens + i)) {
+			depth += 1;
+			continue;
+		}
+
+		if(tokens[i].subtype == TokenSubtype_PERIOD
+		&& depth != 0)
+			depth -= 1;
+		else if(tokens[i].subtype != TokenSubtype_SEMICOLON)
+			continue;
+
+		if(depth != 0
+		|| i + 1 - start < size_unit
+		|| i + 1 == end
+		|| parser_is_scope_L(tokens + i + 1))
+			continue;
+
+		units[count].start = start;
+		units[count].end = i + 1;
+		count += 1;
+		start = i + 1;
+	}
+
+	units[count].start = start;
+	units[count].end = end;
+	return count + 1;
+}
+
+static void* parse_unit(void* argument) {
+	ParserUnit* unit = (ParserUnit*) argument;
+	unit->status = parser_create_allocators(&unit->parser)
+	&& parser_parse_tokens(
+		unit->start,
+		unit->end,
+		&unit->parser);
+	return NULL;
+}
+// the chain of the type of an identification follows it, unless the type is shared
+static bool is_chain_owned(
+const Node* nodes,
+uint32_t node) {
+	return !nodes[node].is_child
+	    && nodes[node].type == NodeType_IDENTIFICATION
+	    && nodes[node].child1 == node + 1;
+}
+
+/*
+ * the chain at `head` in the unit copied after the nodes of the parser, then interned as when parsed in one pass:
+ * a type already known in a previous unit is shared, the copy being released
+ * return the node after the chain in the unit, 0 if an allocation fails
+*/
+static uint32_t append_chain(
+const Parser* unit,
+uint32_t head,
+uint32_t* map,
+Parser* parser) {
+	const Node* nodes_unit = (const Node*) unit->nodes.addr;
+	const uint32_t start = (uint32_t) parser->count_nodes;
+	uint32_t end = head;
+
+	for(;
+	end == head
+	|| nodes_unit[end - 1].child1 != 0;
+	end += 1) {
+		Node* node = (Node*) parser->nodes.addr + parser->count_nodes;
+		*node = nodes_unit[end];
+		// the links of a chain follow each other
+		if(node->child1 != 0)
+			node->child1 = (uint32_t) parser->count_nodes + 1;
+
+		parser->count_nodes += 1;
+	}
+
+	const uint32_t type = parser_type_intern(
+		start,
+		parser);
+
+	if(type == 0)
+		return 0;
+
+	if(type != start)
+		parser->count_nodes = start;
+
+	for(uint32_t i = head;
+	i < end;
+	i += 1) map[i] = type + i - head;
+
+	return end;
+}
+
+static uint32_t relocate(
+const uint32_t* map,
+uint32_t node) {
+	return node != 0 ? map[node] : 0;
+}
+
+/*
+ * the nodes of the unit after the ones of the parser, the indexes being moved by `map`,
+ * so the nodes are the ones of a parse in one pass
+*/
+static bool append_unit(
+const Parser* unit,
+Parser* parser) {
+	const Node* nodes_unit = (const Node*) unit->nodes.addr;
+	const size_t count_symbols = parser->symbols.count_symbols;
+	MemoryArea area_map;
+	initialize_memory_area(&area_map);
+
+	if(!parser_allocator_reserve(
+		unit->count_nodes - 1, // without the null node
+		parser)
+	|| create_memory_area(
+		unit->count_nodes,
+		sizeof(uint32_t),
+		&area_map)
+	== false)
+		return false;
+	// the index in the parser of each node of the unit
+	uint32_t* map = (uint32_t*) area_map.addr;
+	Node* nodes = (Node*) parser->nodes.addr;
+	// the children are moved once all the nodes are placed, as they may come later
+	for(uint32_t i = 1;
+	i < unit->count_nodes;) {
+		map[i] = (uint32_t) parser->count_nodes;
+		nodes[parser->count_nodes] = nodes_unit[i];
+		parser->count_nodes += 1;
+
+		if(!is_chain_owned(
+			nodes_unit,
+			i)) {
+			i += 1;
+			continue;
+		}
+
+		i = append_chain(
+			unit,
+			i + 1,
+			map,
+			parser);
+
+		if(i == 0)
+			goto DESTROY;
+	}
+
+	for(uint32_t i = 1;
+	i < unit->count_nodes;
+	i += 1) {
+		Node* node = nodes + map[i];
+
+		if(is_chain_owned(
+			nodes_unit,
+			i)) {
+			node->child1 = map[i + 1];
+			node->child2 = relocate(
+				map,
+				node->child2);
+			// the links, moved with their chain
+			for(i += 1;
+			nodes_unit[i].child1 != 0;
+			i += 1);
+
+			continue;
+		}
+
+		if(!node->is_child
+		&& node->type == NodeType_SCOPE_START) {
+			// the end is 0 while the scope is not closed
+			if(node->child != 0) {
+				node->child = map[node->child];
+				node->value = node->child - map[i];
+			}
+
+			continue;
+		}
+
+		node->child1 = relocate(
+			map,
+			node->child1);
+		node->child2 = relocate(
+			map,
+			node->child2);
+	}
+
+	if(!parser_signature_merge(
+		unit,
+		map,
+		parser)
+	|| !parser_qualifier_merge(
+		unit,
+		map,
+		parser)
+	// before the symbols of the unit, which were visible in the unit
+	|| !parser_call_resolve_unit(
+		unit,
+		map,
+		parser))
+		goto DESTROY;
+
+	const ParserSymbol* symbols = (const ParserSymbol*) unit->symbols.symbols.addr;
+
+	for(size_t i = 0;
+	i < unit->symbols.count_symbols;
+	i += 1) {
+		if(parser_symbol_add(
+			symbols[i].name,
+			map[symbols[i].node],
+			&parser->symbols)
+		== false)
+			goto DESTROY;
+	}
+	const ParserTop* tops = (const ParserTop*) unit->tops.addr;
+
+	for(size_t i = 0;
+	i < unit->count_tops;
+	i += 1) {
+		if(!parser_allocator_top(parser))
+			goto DESTROY;
+
+		((ParserTop*) parser->tops.addr)[parser->count_tops] = (ParserTop) {
+			.token = tops[i].token,
+			.node = map[tops[i].node]};
+		parser->count_tops += 1;
+	}
+	// only the last unit may have open scopes
+	const ParserScope* scopes = (const ParserScope*) unit->scopes.addr;
+
+	for(size_t i = 0;
+	i < unit->count_scopes;
+	i += 1) {
+		if(!parser_allocator_scope(parser))
+			goto DESTROY;
+
+		((ParserScope*) parser->scopes.addr)[parser->count_scopes] = (ParserScope) {
+			.node = map[scopes[i].node],
+			.count_symbols = scopes[i].count_symbols + count_symbols};
+		parser->count_scopes += 1;
+	}
+
+	destroy_memory_area(&area_map);
+	return true;
+DESTROY:
+	destroy_memory_area(&area_map);
+	return false;
+}
+
+/*
+ * return 0 if the file is too small to be cut, the parser being untouched
+ * the calls still to be resolved are left in `Parser.fixups`
+*/
+int parser_parallel_create(Parser* parser) {
+	assert(parser != NULL);
+
+	const Lexer* lexer = parser->lexer;
+	size_t count_units = lexer->tokens.count / PARSER_PARALLEL_MIN_TOKENS;
+	const size_t count_max = count_threads();
+
+	if(count_units > count_max)
+		count_units = count_max;
+
+	if(count_units > COUNT_UNIT_MAX)
+		count_units = COUNT_UNIT_MAX;
+
+	if(count_units < 2)
+		return 0;
+
+	ParserUnit units[COUNT_UNIT_MAX];
+	count_units = split_units(
+		lexer,
+		count_units,
+		units);
+
+	if(count_units < 2)
+		return 0;
+
+	for(size_t i = 0;
+	i < count_units;
+	i += 1) {
+		initialize_parser(&units[i].parser);
+		units[i].parser.lexer = lexer;
+		units[i].is_thread = false;
+		units[i].status = false;
+	}
+	// the first unit is parsed by this thread
+	for(size_t i = 1;
+	i < count_units;
+	i += 1) {
+		units[i].is_thread = pthread_create(
+			&units[i].thread,
+			NULL,
+			parse_unit,
+			units + i)
+		== 0;
+	}
+
+	for(size_t i = 0;
+	i < count_units;
+	i += 1) {
+		if(units[i].is_thread)
+			pthread_join(
+				units[i].thread,
+				NULL);
+		else
+			parse_unit(units + i);
+	}
+
+	int status = 1;
+
+	if(!parser_create_allocators(parser))
+		status = -1;
+
+	for(size_t i = 0;
+	i < count_units;
+	i += 1) {
+		if(status == 1
+		&& (!units[i].status
+		 || !append_unit(
+			&units[i].parser,
+			parser)))
+			status = -1;
+
+		destroy_parser(&units[i].parser);
+	}
+
+	return status;
+}
+
+#undef COUNT_UNIT_MAX
+#undef PARSER_PARALLEL_MIN_TOKENS
+#undef PARSER_PARALLEL_THREADS
@@ -0,0 +1,192 @@
+#include <assert.h>
+#include <string.h>
+#include "parser_allocator.h"
+#include "parser_qualifier.h"
+#include "parser_utils.h"
+
+/*
+ * the qualifiers of an identification are bits of its subtype, the ones without a bit are kept
+ * in a table ordered by node, so an identification carries no node for its qualifiers
+*/
+
+#define CHUNK_QUALIFIER 16
+
+typedef struct {
+	const char* name;
+	long int length;
+	NodeSubtypeIdentificationBitQualifier bit;
+} QualifierKnown;
+
+// on the left only
+static const QualifierKnown qualifiers_known[] = {
+	{"mut", 3, NodeSubtypeIdentificationBitQualifier_MUT},
+	{"entry", 5, NodeSubtypeIdentificationBitQualifier_ENTRY}};
+
+void parser_initialize_qualifiers(ParserQualifierTable* qualifiers) {
+	assert(qualifiers != NULL);
+
+	initialize_memory_area(&qualifiers->qualifiers);
+	qualifiers->count_qualifiers = 0;
+}
+
+bool parser_create_qualifiers(ParserQualifierTable* qualifiers) {
+	assert(qualifiers != NULL);
+
+	if(create_memory_area(
+		CHUNK_QUALIFIER,
+		sizeof(ParserQualifier),
+		&qualifiers->qualifiers)
+	== false)
+		return false;
+
+	qualifiers->count_qualifiers = 0;
+	return true;
+}
+
+void parser_destroy_qualifiers(ParserQualifierTable* qualifiers) {
+	if(qualifiers == NULL)
+		return;
+
+	destroy_memory_area(&qualifiers->qualifiers);
+	parser_initialize_qualifiers(qualifiers);
+}
+
+static bool qualifier_append(
+uint32_t node,
+uint32_t token,
+ParserQualifierTable* qualifiers) {
+	if(qualifiers->count_qualifiers == qualifiers->qualifiers.count
+	&& !memory_area_realloc(
+		qualifiers->qualifiers.count * 2,
+		&qualifiers->qualifiers))
+		return false;
+
+	((ParserQualifier*) qualifiers->qualifiers.addr)[qualifiers->count_qualifiers] = (ParserQualifier) {
+		.node = node,
+		.token = token};
+	qualifiers->count_qualifiers += 1;
+	return true;
+}
+
+// `NodeSubtypeIdentificationBitQualifier_CUSTOM` if the qualifier has no bit of its own
+static NodeSubtypeIdentificationBitQualifier qualifier_bit(
+const char* code,
+const Token* token) {
+	if(token->subtype != (TokenSubtype) TokenType_QL)
+		return NodeSubtypeIdentificationBitQualifier_CUSTOM;
+
+	const long int length = token->L_end - token->L_start;
+
+	for(size_t i = 0;
+	i < sizeof(qualifiers_known) / sizeof(*qualifiers_known);
+	i += 1) {
+		if(length == qualifiers_known[i].length
+		&& memcmp(
+			code + token->L_start,
+			qualifiers_known[i].name,
+			(size_t) length)
+		== 0)
+			return qualifiers_known[i].bit;
+	}
+
+	return NodeSubtypeIdentificationBitQualifier_CUSTOM;
+}
+
+/*
+ * read the qualifiers written before the command of an identification into its subtype,
+ * the ones without a bit added to the table
+ * the identifications being added in the order of the nodes, the table stays ordered
+*/
+bool parser_qualifier_add(
+uint32_t node,
+Parser* parser) {
+	assert(parser != NULL);
+
+	const char* code = parser->lexer->source->content;
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	Node* identification = parser_allocator_node(
+		parser,
+		node);
+	assert(identification->is_child == false);
+	assert(identification->type == NodeType_IDENTIFICATION);
+	assert(identification->token >= 1);
+	// the token before the identifier is the command
+	const uint32_t end = identification->token - 1;
+	uint32_t start = end;
+
+	while(start > 0
+	   && parser_is_qualifier(tokens + start - 1)) start -= 1;
+
+	for(uint32_t i = start;
+	i < end;
+	i += 1) {
+		const NodeSubtypeIdentificationBitQualifier bit = qualifier_bit(
+			code,
+			tokens + i);
+		identification->subtype |= bit;
+
+		if(bit == NodeSubtypeIdentificationBitQualifier_CUSTOM
+		&& !qualifier_append(
+			node,
+			i,
+			&parser->qualifiers))
+			return false;
+	}
+
+	return true;
+}
+
+// the qualifiers without a bit of an identification, NULL if none
+const ParserQualifier* parser_qualifier_find(
+uint32_t node,
+const Parser* parser,
+size_t* count) {
+	assert(parser != NULL);
+	assert(count != NULL);
+
+	const ParserQualifier* qualifiers = (const ParserQualifier*) parser->qualifiers.qualifiers.addr;
+	size_t low = 0;
+	size_t high = parser->qualifiers.count_qualifiers;
+	// the first one of the node or after it
+	while(low < high) {
+		const size_t middle = low + (high - low) / 2;
+
+		if(qualifiers[middle].node < node)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	for(high = low;
+	high < parser->qualifiers.count_qualifiers
+	&& qualifiers[high].node == node;
+	high += 1);
+
+	*count = high - low;
+	return *count != 0 ? qualifiers + low : NULL;
+}
+
+// the qualifiers of a unit parsed apart, whose nodes are moved to `map` in the same order
+bool parser_qualifier_merge(
+const Parser* unit,
+const uint32_t* map,
+Parser* parser) {
+	assert(unit != NULL);
+	assert(parser != NULL);
+
+	const ParserQualifier* qualifiers = (const ParserQualifier*) unit->qualifiers.qualifiers.addr;
+
+	for(size_t i = 0;
+	i < unit->qualifiers.count_qualifiers;
+	i += 1) {
+		if(!qualifier_append(
+			map[qualifiers[i].node],
+			qualifiers[i].token,
+			&parser->qualifiers))
+			return false;
+	}
+
+	return true;
+}
+
+#undef CHUNK_QUALIFIER
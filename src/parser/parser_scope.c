@@ -1,37 +1,9 @@
 #include <assert.h>
 #include "parser_allocator.h"
 #include "parser_scope.h"
+#include "parser_symbol.h"
 #include "parser_utils.h"
 
-static Node* parser_get_scope_from_period(Parser* parser) {
-	Node* node = (Node*) parser->nodes.top;
-	MemoryChainLink* restrict link = parser->nodes.last;
-	size_t count_scope_nest = 1;
-	uint64_t count = 0;
-
-	do {
-		// get the last node in the previous memory area
-		if(node == link->memArea.addr) {
-			link = link->previous;
-			node = (Node*) link->memArea.addr + link->memArea.count - 1;
-		} else
-			node -= 1;
-
-		if(!node->is_child) {
-			switch(node->type) {
-			case NodeType_SCOPE_END: count_scope_nest += 1; break;
-			case NodeType_SCOPE_START: count_scope_nest -= 1; break;
-			}
-		}
-
-		count += 1;
-	} while(count_scope_nest != 0
-	     || node->type != NodeType_SCOPE_START);
-
-	node->value = count;
-	return node;
-}
-
 bool if_scope_create_node(
 size_t i,
 Parser* parser) {
@@ -42,15 +14,24 @@ Parser* parser) {
 	if(!parser_is_scope_L(token))
 		return false;
 
-	if(!parser_allocator(parser))
+	if(!parser_allocator(parser)
+	|| !parser_allocator_scope(parser))
 		return false;
 
-	*((Node*) parser->nodes.top) = (Node) {
+	const uint32_t index = parser_allocator_index(parser);
+	*parser_allocator_node(
+		parser,
+		index) = (Node) {
 		.is_child = false,
 		.type = NodeType_SCOPE_START,
 		.subtype = NodeSubtypeScope_NO,
 		.value = 0,
-		.child = NULL};
+		.child = 0};
+	// paired with its period by `if_period_create_node`
+	((ParserScope*) parser->scopes.addr)[parser->count_scopes] = (ParserScope) {
+		.node = index,
+		.count_symbols = parser->symbols.count_symbols};
+	parser->count_scopes += 1;
 	return true;
 }
 
@@ -64,14 +45,30 @@ Parser* parser) {
 	if(token->subtype != TokenSubtype_PERIOD)
 		return 0;
 
+	if(parser->count_scopes == 0)
+		return -1;
+
 	if(!parser_allocator(parser))
 		return -1;
 
-	Node* scope = parser_get_scope_from_period(parser);
-	*((Node*) parser->nodes.top) = (Node) {
+	parser->count_scopes -= 1;
+	const ParserScope* open = (ParserScope*) parser->scopes.addr + parser->count_scopes;
+	const uint32_t index = parser_allocator_index(parser);
+	Node* scope = parser_allocator_node(
+		parser,
+		open->node);
+	// the number of nodes from the start to the end of the scope
+	scope->value = index - open->node;
+	scope->child = index;
+	*parser_allocator_node(
+		parser,
+		index) = (Node) {
 		.is_child = false,
 		.type = NodeType_SCOPE_END,
 		.subtype = scope->subtype};
-	scope->child = (Node*) parser->nodes.top;
+	// the names identified in the scope go out of scope
+	parser_symbol_pop(
+		open->count_symbols,
+		&parser->symbols);
 	return 1;
 }
@@ -0,0 +1,284 @@
+#include <assert.h>
+#include "parser_allocator.h"
+#include "parser_signature.h"
+#include "parser_type_table.h"
+
+#define CHUNK_SIGNATURE 16
+#define CHUNK_PARAMETER 32
+#define CHUNK_TABLE 32 // power of 2
+
+void parser_initialize_signatures(ParserSignatureTable* signatures) {
+	assert(signatures != NULL);
+
+	initialize_memory_area(&signatures->signatures);
+	signatures->count_signatures = 0;
+	initialize_memory_area(&signatures->parameters);
+	signatures->count_parameters = 0;
+	initialize_memory_area(&signatures->table);
+}
+
+bool parser_create_signatures(ParserSignatureTable* signatures) {
+	assert(signatures != NULL);
+
+	if(create_memory_area(
+		CHUNK_SIGNATURE,
+		sizeof(ParserSignature),
+		&signatures->signatures)
+	== false
+	|| create_memory_area(
+		CHUNK_PARAMETER,
+		sizeof(uint32_t),
+		&signatures->parameters)
+	== false
+	// the slots are zeroed, so empty
+	|| create_memory_area(
+		CHUNK_TABLE,
+		sizeof(ParserSignatureSlot),
+		&signatures->table)
+	== false)
+		return false;
+
+	signatures->count_signatures = 0;
+	signatures->count_parameters = 0;
+	return true;
+}
+
+void parser_destroy_signatures(ParserSignatureTable* signatures) {
+	if(signatures == NULL)
+		return;
+
+	destroy_memory_area(&signatures->signatures);
+	destroy_memory_area(&signatures->parameters);
+	destroy_memory_area(&signatures->table);
+	parser_initialize_signatures(signatures);
+}
+
+static size_t slot_first(
+uint32_t node,
+size_t mask) {
+	return (size_t) (node * UINT32_C(0x9E3779B1)) & mask;
+}
+
+static bool table_grow(ParserSignatureTable* signatures) {
+	const ParserSignatureSlot* const table_old = (const ParserSignatureSlot*) signatures->table.addr;
+	const size_t count_old = signatures->table.count;
+	MemoryArea table;
+
+	if(create_memory_area(
+		count_old * 2,
+		sizeof(ParserSignatureSlot),
+		&table)
+	== false)
+		return false;
+
+	const size_t mask = table.count - 1;
+
+	for(size_t i = 0;
+	i < count_old;
+	i += 1) {
+		if(table_old[i].node == 0)
+			continue;
+
+		size_t j = slot_first(
+			table_old[i].node,
+			mask);
+
+		while(((ParserSignatureSlot*) table.addr)[j].node != 0) j = (j + 1) & mask;
+
+		((ParserSignatureSlot*) table.addr)[j] = table_old[i];
+	}
+
+	destroy_memory_area(&signatures->table);
+	signatures->table = table;
+	return true;
+}
+
+// room for one more element after `count` ones
+static bool area_grow(
+size_t count,
+MemoryArea* memArea) {
+	if(count < memArea->count)
+		return true;
+
+	return memory_area_realloc(
+		memArea->count * 2,
+		memArea);
+}
+
+static bool is_parameter(const Node* node) {
+	return node->is_child
+	    && node->type == NodeTypeChildType_LOCK
+	    && node->subtype == NodeSubtypeChildTypeScoped_PARAMETER;
+}
+
+// the type of a parameter goes up to the next parameter or to the null link ending the chain
+static uint32_t parameter_end(
+uint32_t link,
+const Parser* parser) {
+	for(;
+	;
+	link = parser_allocator_node(
+		parser,
+		link)->child1) {
+		const Node* node = parser_allocator_node(
+			parser,
+			link);
+
+		if(is_parameter(node)
+		|| node->type == NodeTypeChildType_NO)
+			return link;
+	}
+}
+
+/*
+ * read the chain of the type of a parameterized label once, other nodes have no signature
+ * the parameters of the labels taken as parameters are not in the chain, so the ones found are the label's
+ * the types are interned in `Parser.types`, so two labels taking the same types have the same IDs
+*/
+bool parser_signature_add(
+uint32_t node,
+Parser* parser) {
+	assert(parser != NULL);
+
+	ParserSignatureTable* const signatures = &parser->signatures;
+	const Node* label = parser_allocator_node(
+		parser,
+		node);
+
+	if(label->is_child
+	|| label->type != NodeType_IDENTIFICATION
+	|| (label->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_SCOPED) != NodeSubtypeIdentificationBitScoped_LABEL_PARAMETERIZED)
+		return true;
+
+	if(signatures->count_signatures * 2 >= signatures->table.count
+	&& table_grow(signatures) == false)
+		return false;
+
+	if(!area_grow(
+		signatures->count_signatures,
+		&signatures->signatures))
+		return false;
+
+	ParserSignature signature = {
+		.node = node,
+		.type_return = 0,
+		.parameters = (uint32_t) signatures->count_parameters,
+		.count_parameters = 0,
+		.command = label->subtype & MASK_BIT_NODE_SUBTYPE_IDENTIFICATION_COMMAND};
+	uint32_t link = label->child1;
+	// the chain starts with what the label returns, a lock alone
+	if(link != 0
+	&& parser_allocator_node(
+		parser,
+		link)->subtype == NodeSubtypeChildTypeScoped_RETURN_TYPE) {
+		signature.type_return = parser_type_intern_part(
+			link,
+			parser_allocator_node(
+				parser,
+				link)->child1,
+			parser);
+
+		if(signature.type_return == 0)
+			return false;
+	}
+
+	for(;
+	link != 0;
+	link = parser_allocator_node(
+		parser,
+		link)->child1) {
+		const Node* parameter = parser_allocator_node(
+			parser,
+			link);
+
+		if(!is_parameter(parameter))
+			continue;
+
+		if(signature.count_parameters == UINT16_MAX
+		|| !area_grow(
+			signatures->count_parameters,
+			&signatures->parameters))
+			return false;
+
+		const uint32_t type = parser_type_intern_part(
+			parameter->child1,
+			parameter_end(
+				parameter->child1,
+				parser),
+			parser);
+
+		if(type == 0)
+			return false;
+
+		((uint32_t*) signatures->parameters.addr)[signatures->count_parameters] = type;
+		signatures->count_parameters += 1;
+		signature.count_parameters += 1;
+	}
+
+	ParserSignatureSlot* const table = (ParserSignatureSlot*) signatures->table.addr;
+	const size_t mask = signatures->table.count - 1;
+	size_t i = slot_first(
+		node,
+		mask);
+
+	while(table[i].node != 0) i = (i + 1) & mask;
+
+	table[i] = (ParserSignatureSlot) {
+		.node = node,
+		.signature = (uint32_t) signatures->count_signatures};
+	((ParserSignature*) signatures->signatures.addr)[signatures->count_signatures] = signature;
+	signatures->count_signatures += 1;
+	return true;
+}
+
+// NULL if the node is not a parameterized label
+const ParserSignature* parser_signature_find(
+uint32_t node,
+const Parser* parser) {
+	assert(parser != NULL);
+
+	const ParserSignatureTable* const signatures = &parser->signatures;
+
+	if(signatures->count_signatures == 0)
+		return NULL;
+
+	const ParserSignatureSlot* const table = (const ParserSignatureSlot*) signatures->table.addr;
+	const size_t mask = signatures->table.count - 1;
+
+	for(size_t i = slot_first(
+		node,
+		mask);
+	table[i].node != 0;
+	i = (i + 1) & mask) {
+		if(table[i].node == node)
+			return (const ParserSignature*) signatures->signatures.addr + table[i].signature;
+	}
+
+	return NULL;
+}
+
+// the signatures of a unit parsed apart, whose nodes are moved to `map`, read again from the moved nodes
+bool parser_signature_merge(
+const Parser* unit,
+const uint32_t* map,
+Parser* parser) {
+	assert(unit != NULL);
+	assert(parser != NULL);
+
+	const ParserSignature* const signatures = (const ParserSignature*) unit->signatures.signatures.addr;
+
+	for(size_t i = 0;
+	i < unit->signatures.count_signatures;
+	i += 1) {
+		if(!parser_signature_add(
+			map[signatures[i].node],
+			parser))
+			return false;
+	}
+
+	return true;
+}
+
+#undef CHUNK_TABLE
+#undef CHUNK_PARAMETER
+#undef CHUNK_SIGNATURE
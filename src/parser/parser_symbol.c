@@ -0,0 +1,191 @@
+#include <assert.h>
+#include "parser_symbol.h"
+
+#define CHUNK_SYMBOL 64
+#define CHUNK_TABLE 128 // power of 2
+
+void parser_initialize_symbols(ParserSymbolTable* symbols) {
+	assert(symbols != NULL);
+
+	initialize_memory_area(&symbols->symbols);
+	symbols->count_symbols = 0;
+	initialize_memory_area(&symbols->table);
+	symbols->count_table = 0;
+}
+
+bool parser_create_symbols(ParserSymbolTable* symbols) {
+	assert(symbols != NULL);
+
+	if(create_memory_area(
+		CHUNK_SYMBOL,
+		sizeof(ParserSymbol),
+		&symbols->symbols)
+	== false)
+		return false;
+	// the slots are zeroed, so empty
+	if(create_memory_area(
+		CHUNK_TABLE,
+		sizeof(ParserSymbolSlot),
+		&symbols->table)
+	== false)
+		return false;
+
+	symbols->count_symbols = 0;
+	symbols->count_table = 0;
+	return true;
+}
+
+void parser_destroy_symbols(ParserSymbolTable* symbols) {
+	if(symbols == NULL)
+		return;
+
+	destroy_memory_area(&symbols->table);
+	destroy_memory_area(&symbols->symbols);
+	parser_initialize_symbols(symbols);
+}
+
+// the name of the key of the token in the interner, 0 if none
+uint32_t parser_symbol_name(
+const Lexer* lexer,
+const Token* token) {
+	// a name called after an operator is lexed as an R token
+	const uint32_t name = token->type == TokenType_R ? token->R_name : token->L_name;
+
+	if(name == 0)
+		return 0;
+
+	return ((const LiteralString*) lexer->strings.addr)[name].id;
+}
+
+// the IDs are consecutive, a multiplicative hash spreads them over the table
+static size_t slot_hash(
+uint32_t name,
+size_t mask) {
+	return (size_t) ((name * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+}
+// get the slot of the name, or the empty slot where it should be inserted
+static ParserSymbolSlot* slot_find(
+uint32_t name,
+const ParserSymbolTable* symbols) {
+	ParserSymbolSlot* const table = (ParserSymbolSlot*) symbols->table.addr;
+	const size_t mask = symbols->table.count - 1;
+	size_t i = slot_hash(
+		name,
+		mask);
+
+	while(table[i].name != 0
+	   && table[i].name != name) i = (i + 1) & mask;
+
+	return table + i;
+}
+
+static bool table_grow(ParserSymbolTable* symbols) {
+	const ParserSymbolSlot* const table_old = (const ParserSymbolSlot*) symbols->table.addr;
+	const size_t count_old = symbols->table.count;
+	MemoryArea table;
+
+	if(create_memory_area(
+		count_old * 2,
+		sizeof(ParserSymbolSlot),
+		&table)
+	== false)
+		return false;
+
+	const size_t mask = table.count - 1;
+
+	for(size_t i = 0;
+	i < count_old;
+	i += 1) {
+		if(table_old[i].name == 0)
+			continue;
+
+		size_t j = slot_hash(
+			table_old[i].name,
+			mask);
+
+		while(((ParserSymbolSlot*) table.addr)[j].name != 0) j = (j + 1) & mask;
+
+		((ParserSymbolSlot*) table.addr)[j] = table_old[i];
+	}
+
+	destroy_memory_area(&symbols->table);
+	symbols->table = table;
+	return true;
+}
+// the node shadows the symbol of the same name until the end of the current scope
+bool parser_symbol_add(
+uint32_t name,
+uint32_t node,
+ParserSymbolTable* symbols) {
+	assert(node != 0);
+	assert(symbols != NULL);
+
+	if(name == 0)
+		return true;
+
+	if(symbols->count_symbols == symbols->symbols.count
+	&& memory_area_realloc(
+		symbols->symbols.count * 2,
+		&symbols->symbols)
+	== false)
+		return false;
+
+	if(symbols->count_table * 2 >= symbols->table.count
+	&& table_grow(symbols) == false)
+		return false;
+
+	ParserSymbolSlot* const slot = slot_find(
+		name,
+		symbols);
+
+	if(slot->name == 0) {
+		slot->name = name;
+		symbols->count_table += 1;
+	}
+
+	((ParserSymbol*) symbols->symbols.addr)[symbols->count_symbols] = (ParserSymbol) {
+		.node = node,
+		.name = name,
+		.shadowed = slot->symbol};
+	symbols->count_symbols += 1;
+	slot->symbol = (uint32_t) symbols->count_symbols;
+	return true;
+}
+
+// the index of the identification of the name, 0 if out of scope
+uint32_t parser_symbol_find(
+uint32_t name,
+const ParserSymbolTable* symbols) {
+	assert(symbols != NULL);
+
+	if(name == 0)
+		return 0;
+
+	const ParserSymbolSlot* slot = slot_find(
+		name,
+		symbols);
+
+	if(slot->symbol == 0)
+		return 0;
+
+	return ((const ParserSymbol*) symbols->symbols.addr)[slot->symbol - 1].node;
+}
+// forget the symbols added after the first `count_symbols` ones, the shadowed ones are visible again
+void parser_symbol_pop(
+size_t count_symbols,
+ParserSymbolTable* symbols) {
+	assert(symbols != NULL);
+	assert(count_symbols <= symbols->count_symbols);
+
+	const ParserSymbol* const stack = (const ParserSymbol*) symbols->symbols.addr;
+
+	while(symbols->count_symbols > count_symbols) {
+		symbols->count_symbols -= 1;
+		slot_find(
+			stack[symbols->count_symbols].name,
+			symbols)->symbol = stack[symbols->count_symbols].shadowed;
+	}
+}
+
+#undef CHUNK_TABLE
+#undef CHUNK_SYMBOL
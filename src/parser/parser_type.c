@@ -3,6 +3,7 @@
 #include "lexer.h"
 #include "parser_allocator.h"
 #include "parser_type.h"
+#include "parser_type_table.h"
 #include "parser_utils.h"
 
 /*
@@ -30,22 +31,41 @@ static NodeSubtypeChildTypeModifier operator_modifier_to_subtype_right(TokenSubt
 }
 */
 
+typedef enum: uint8_t {
+#define TYPE_STATE(type) TypeState_ ## type
+	TYPE_STATE(LOCK), // a type, or the parentheses of a label
+	TYPE_STATE(R_LPARENTHESIS), // a parameter may hold the parenthesis
+	TYPE_STATE(OPEN), // a label returning nothing
+	TYPE_STATE(NEXT), // after a type or an open parenthesis
+	TYPE_STATE(PARAMETER), // after an open parenthesis or a comma
+	TYPE_STATE(KEY), // the name of a parameter
+	TYPE_STATE(CLOSE),
+	TYPE_STATE(END),
+#undef TYPE_STATE
+} TypeState;
+
+// `token` is an index in `Lexer.tokens`, the node is bound to the previous one
 static bool type_bind_child_token(
 NodeTypeChildType type,
 NodeSubtype subtype,
-const Token* token,
+uint32_t token,
 Parser* parser) {
 	if(!parser_allocator(parser))
 		return false;
 
-	*((Node*) parser->nodes.top) = (Node) {
+	const uint32_t index = parser_allocator_index(parser);
+	*parser_allocator_node(
+		parser,
+		index) = (Node) {
 		.is_child = true,
 		.type = type,
 		.subtype = subtype,
 		.token = token,
-		.child1 = NULL,
-		.child2 = NULL};
-	((Node*) parser->nodes.previous)->child1 = (Node*) parser->nodes.top;
+		.child1 = 0,
+		.child2 = 0};
+	parser_allocator_node(
+		parser,
+		index - 1)->child1 = index;
 	return true;
 }
 /*
@@ -116,205 +136,234 @@ Parser* parser) {
 	return true;
 }
 */
+// the parentheses open in the type, the first level is outside of them
+static ParserTypeNest* nest_top(const Parser* parser) {
+	return (ParserTypeNest*) parser->nests.addr + parser->count_nests - 1;
+}
+
+static bool nest_push(Parser* parser) {
+	if(!parser_allocator_nest(parser))
+		return false;
+
+	((ParserTypeNest*) parser->nests.addr)[parser->count_nests] = (ParserTypeNest) {
+		.is_filled = false};
+	parser->count_nests += 1;
+	return true;
+}
+
+/*
+ * the type is read from a state to the next one, the open parentheses being kept in `Parser.nests`
+ * return 0 if the tokens do not make a type, the nodes created being left to the failed parse
+*/
 int if_type_create_nodes(
 size_t* i,
-MemoryArea* restrict memArea,
 NodeSubtypeIdentificationBitScoped* restrict bit_scoped,
 Parser* parser) {
 	assert(i != NULL);
-	assert(memArea != NULL);
 	assert(bit_scoped != NULL);
 	assert(parser != NULL);
 
 	size_t buffer_i = *i;
-	char* const memory = memArea->addr;
+	// the chain is bound to the node before it
+	const uint32_t head = (uint32_t) parser->count_nodes;
 	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	uint32_t lock = 0; // the last type, returned by the label if followed by parentheses
 	*bit_scoped = NodeSubtypeIdentificationBitScoped_NO;
-	// if the current scope has at least one parameter memArea->addr[count_parenthesis_nest] is set to 1
-	size_t count_parenthesis_nest = 0;
-
-	if(parser_is_R_left_parenthesis(tokens + buffer_i))
-		goto R_LPARENTHESIS_SKIP_PARAMETER;
-
-	do {
-		Node* lock;
-TYPE:
-		// lock alone
-		
-		/*
-		if(parse_type_lock_left(
-			&buffer_i,
-			parser)
-		== false)
-			return false;
-		*/
-		if(tokens[buffer_i].subtype != TokenSubtype_LPARENTHESIS) {
-			if(type_bind_child_token(
-				NodeTypeChildType_LOCK,
-				(NodeSubtype) NodeSubtypeChild_NO,
-				tokens + buffer_i,
-				parser)
-			== false)
-				return -1;
+	parser->count_nests = 0;
 
-			size_t i_lock = buffer_i;
-			lock = (Node*) parser->nodes.top;
-			buffer_i += 1;
-			memory[count_parenthesis_nest] = 1;
-			/*
-			if(parse_type_lock_right(
-				&buffer_i,
-				parser)
-			== false)
-				NodeSubtypeIdentificationBitScoped_INVALID;
-			*/
-			if(tokens[buffer_i].subtype != TokenSubtype_LPARENTHESIS
-			&& count_parenthesis_nest == 0) {
-				if(parser_is_scope_R(tokens + i_lock))
-					*bit_scoped = NodeSubtypeIdentificationBitScoped_LABEL;
+	if(!nest_push(parser))
+		return -1;
 
-				break;
+	TypeState state = parser_is_R_left_parenthesis(tokens + buffer_i) ? TypeState_OPEN : TypeState_LOCK;
+
+	while(state != TypeState_END) {
+		// 0 outside of the parentheses
+		const size_t count_parenthesis_nest = parser->count_nests - 1;
+
+		switch(state) {
+		case TypeState_LOCK:
+			if(tokens[buffer_i].subtype != TokenSubtype_LPARENTHESIS) {
+				if(type_bind_child_token(
+					NodeTypeChildType_LOCK,
+					(NodeSubtype) NodeSubtypeChild_NO,
+					(uint32_t) buffer_i,
+					parser)
+				== false)
+					return -1;
+
+				lock = parser_allocator_index(parser);
+				buffer_i += 1;
+				nest_top(parser)->is_filled = true;
+				// lock alone
+				if(tokens[buffer_i].subtype != TokenSubtype_LPARENTHESIS
+				&& count_parenthesis_nest == 0) {
+					if(parser_is_scope_R(tokens + buffer_i - 1))
+						*bit_scoped = NodeSubtypeIdentificationBitScoped_LABEL;
+
+					state = TypeState_END;
+					break;
+				}
 			}
-		}
-		// lock not alone (good luck)
-		*bit_scoped = NodeSubtypeIdentificationBitScoped_LABEL_PARAMETERIZED;
 
-		while(parser_is_R_left_parenthesis(tokens + buffer_i)) {
-R_LPARENTHESIS:
+			*bit_scoped = NodeSubtypeIdentificationBitScoped_LABEL_PARAMETERIZED;
+			state = TypeState_NEXT;
+			break;
+		case TypeState_R_LPARENTHESIS:
+			state = TypeState_OPEN;
+			// a parameter before an R left parenthesis at the first nesting level like in :(a :())
 			if(count_parenthesis_nest > 1
-			// handle R left parenthesis at the first nesting level like in :(a :())
 			|| (count_parenthesis_nest == 1
 			 && !parser_is_parenthesis(tokens + buffer_i - 1)))
-				goto R_LPARENTHESIS_SKIP_PARAMETER;
+				break;
 
 			if(!parser_is_key(tokens + buffer_i))
-				return false;
+				return 0;
 
 			if(type_bind_child_token(
 				NodeTypeChildType_LOCK,
 				(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER,
-				tokens + buffer_i,
+				(uint32_t) buffer_i,
 				parser)
 			== false)
 				return -1;
 
 			buffer_i += 1;
-R_LPARENTHESIS_SKIP_PARAMETER:
+			break;
+		case TypeState_OPEN:
 			if(type_bind_child_token(
 				NodeTypeChildType_LOCK,
 				(NodeSubtype) NodeSubtypeChildTypeScoped_RETURN_NONE,
-				NULL,
+				0,
 				parser)
 			== false)
 				return -1;
 
-			lock = (Node*) parser->nodes.top;
+			lock = parser_allocator_index(parser);
 			buffer_i += 1;
-			memory[count_parenthesis_nest] = 1;
-			count_parenthesis_nest += 1;
-			memory[count_parenthesis_nest] = 0;
-		}
+			nest_top(parser)->is_filled = true;
 
-		if(tokens[buffer_i].subtype == TokenSubtype_LPARENTHESIS) {
-			lock->subtype = NodeSubtypeChildTypeScoped_RETURN_TYPE;
-// LPARENTHESIS:
-			// handle nested empty parenthesis like in :(())
-			if(tokens[buffer_i - 1].subtype == TokenSubtype_LPARENTHESIS)
-				return 0;
+			if(!nest_push(parser))
+				return -1;
 
-			buffer_i += 1;
-			count_parenthesis_nest += 1;
-			memory[count_parenthesis_nest] = 0;
+			state = TypeState_NEXT;
+			break;
+		case TypeState_NEXT:
+			if(parser_is_R_left_parenthesis(tokens + buffer_i)) {
+				state = TypeState_R_LPARENTHESIS;
+			} else if(tokens[buffer_i].subtype == TokenSubtype_LPARENTHESIS) {
+				// handle nested empty parenthesis like in :(())
+				if(lock == 0
+				|| tokens[buffer_i - 1].subtype == TokenSubtype_LPARENTHESIS)
+					return 0;
+
+				parser_allocator_node(
+					parser,
+					lock)->subtype = NodeSubtypeChildTypeScoped_RETURN_TYPE;
+				buffer_i += 1;
 
-			if(parser_is_R_left_parenthesis(tokens + buffer_i))
-				goto R_LPARENTHESIS;
+				if(!nest_push(parser))
+					return -1;
 
-			goto READ_PARAMETER;
-		} else if(tokens[buffer_i].subtype == TokenSubtype_COMMA) {
-COMMA:
-			buffer_i += 1;
-READ_PARAMETER:
+				state = parser_is_R_left_parenthesis(tokens + buffer_i) ? TypeState_R_LPARENTHESIS : TypeState_PARAMETER;
+			} else if(tokens[buffer_i].subtype == TokenSubtype_COMMA) {
+				buffer_i += 1;
+				state = TypeState_PARAMETER;
+			} else if(tokens[buffer_i].subtype == TokenSubtype_RPARENTHESIS) {
+				state = TypeState_CLOSE;
+			} else if(parser_is_key(tokens + buffer_i)) {
+				state = TypeState_KEY;
+			} else if(parser_is_lock(tokens + buffer_i)) {
+				state = TypeState_LOCK;
+			} else
+				return 0;
+
+			break;
+		case TypeState_PARAMETER:
 			if(tokens[buffer_i - 1].subtype == TokenSubtype_LPARENTHESIS
-			&& tokens[buffer_i].subtype == TokenSubtype_RPARENTHESIS)
-				goto RPARENTHESIS;
+			&& tokens[buffer_i].subtype == TokenSubtype_RPARENTHESIS) {
+				state = TypeState_CLOSE;
+				break;
+			}
 
-			memory[count_parenthesis_nest] = 1;
+			nest_top(parser)->is_filled = true;
 
 			if(parser_is_key(tokens + buffer_i)) {
-				// ignore parameter after the first nesting level
-				if(count_parenthesis_nest > 1) {
-					buffer_i += 1;
-					goto TYPE;
-				}
-
-				if(type_bind_child_token(
-					NodeTypeChildType_LOCK,
-					(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER,
-					tokens + buffer_i,
-					parser)
-				== false)
-					return -1;
-
-				buffer_i += 1;
-				goto TYPE;
+				state = TypeState_KEY;
 			} else if(count_parenthesis_nest > 1
 			       && parser_is_lock(tokens + buffer_i)) {
-				goto TYPE;
-			} else {
-				// a lock must succeed a key at the first nesting level
-				return 0;
-			}
-		} else if(tokens[buffer_i].subtype == TokenSubtype_RPARENTHESIS) {
-RPARENTHESIS:
-			if(memory[count_parenthesis_nest] == 0) {
-				if(type_bind_child_token(
-					NodeTypeChildType_LOCK,
-					(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER_NONE,
-					NULL,
-					parser)
-				== false)
-					return -1;
-			}
+				state = TypeState_LOCK;
+			} else
+				return 0; // a lock must succeed a key at the first nesting level
+
+			break;
+		case TypeState_KEY:
+			// the parameters after the first nesting level are ignored
+			if(count_parenthesis_nest <= 1
+			&& type_bind_child_token(
+				NodeTypeChildType_LOCK,
+				(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER,
+				(uint32_t) buffer_i,
+				parser)
+			== false)
+				return -1;
+
+			buffer_i += 1;
+			state = TypeState_LOCK;
+			break;
+		case TypeState_CLOSE:
+			if(!nest_top(parser)->is_filled
+			&& type_bind_child_token(
+				NodeTypeChildType_LOCK,
+				(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER_NONE,
+				0,
+				parser)
+			== false)
+				return -1;
 
 			do {
+				// a parenthesis closed without being open
+				if(parser->count_nests == 1)
+					return 0;
+
 				buffer_i += 1;
-				count_parenthesis_nest -= 1;
+				parser->count_nests -= 1;
 			} while(tokens[buffer_i].subtype == TokenSubtype_RPARENTHESIS);
 
-			if(tokens[buffer_i].subtype == TokenSubtype_COMMA)
-				goto COMMA;
-		} else if(parser_is_key(tokens + buffer_i)) {
-				// keep ignoring parameter after the first nesting level
-				if(count_parenthesis_nest > 1) {
-					buffer_i += 1;
-					goto TYPE;
-				}
-				// a parameter after an R left parenthesis like in :(a :b)
-				if(type_bind_child_token(
-					NodeTypeChildType_LOCK,
-					(NodeSubtype) NodeSubtypeChildTypeScoped_PARAMETER,
-					tokens + buffer_i,
-					parser)
-				== false)
-					return -1;
-
+			if(tokens[buffer_i].subtype == TokenSubtype_COMMA) {
 				buffer_i += 1;
-				goto TYPE;
-		} else if(parser_is_lock(tokens + buffer_i)) {
-			goto TYPE;
-		} else {
-			return 0;
+				state = TypeState_PARAMETER;
+			} else
+				state = parser->count_nests != 1 ? TypeState_LOCK : TypeState_END;
+
+			break;
+		case TypeState_END:
+			break;
 		}
-	} while(count_parenthesis_nest != 0);
+	}
 
-	if(!parser_allocator(parser))
-		return -1;
+	parser->count_nests = 0;
 	// prevent error while checking types
-	*((Node*) parser->nodes.top) = (Node) {
-		.is_child = true,
-		.type = NodeTypeChild_NO,
-		.subtype = NodeSubtype_NO};
-	((Node*) parser->nodes.previous)->child1 = (Node*) parser->nodes.top;
+	if(type_bind_child_token(
+		NodeTypeChildType_NO,
+		(NodeSubtype) NodeSubtype_NO,
+		0,
+		parser)
+	== false)
+		return -1;
+	// an identical type is already known, its chain is shared
+	const uint32_t type = parser_type_intern(
+		head,
+		parser);
+
+	if(type == 0)
+		return -1;
+
+	if(type != head) {
+		parser->count_nodes = head;
+		parser_allocator_node(
+			parser,
+			head - 1)->child1 = type;
+	}
 
 	*i = buffer_i;
 	return 1;
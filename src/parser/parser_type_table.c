@@ -0,0 +1,247 @@
+#include <assert.h>
+#include "parser_allocator.h"
+#include "parser_symbol.h"
+#include "parser_type_table.h"
+
+#define CHUNK_TABLE 128 // power of 2
+
+void parser_initialize_types(ParserTypeTable* types) {
+	assert(types != NULL);
+
+	initialize_memory_area(&types->table);
+	types->count_table = 0;
+}
+
+bool parser_create_types(ParserTypeTable* types) {
+	assert(types != NULL);
+	// the slots are zeroed, so empty
+	if(create_memory_area(
+		CHUNK_TABLE,
+		sizeof(ParserTypeSlot),
+		&types->table)
+	== false)
+		return false;
+
+	types->count_table = 0;
+	return true;
+}
+
+void parser_destroy_types(ParserTypeTable* types) {
+	if(types == NULL)
+		return;
+
+	destroy_memory_area(&types->table);
+	parser_initialize_types(types);
+}
+
+// a node of a chain is known by its kind and the interned name of its token
+static uint32_t node_name(
+const Node* node,
+const Parser* parser) {
+	if(node->token == 0)
+		return 0;
+
+	return parser_symbol_name(
+		parser->lexer,
+		(const Token*) parser->lexer->tokens.addr + node->token);
+}
+
+// the chain from `node` to `end` excluded, to its last link if `end` is 0
+static uint32_t chain_hash(
+uint32_t node,
+uint32_t end,
+const Parser* parser) {
+	uint64_t hash = 0;
+
+	for(;
+	node != end;
+	node = parser_allocator_node(
+		parser,
+		node)->child1) {
+		const Node* link = parser_allocator_node(
+			parser,
+			node);
+		hash = (hash ^ link->type ^ ((uint64_t) link->subtype << 8)) * UINT64_C(0x9E3779B97F4A7C15);
+		hash = (hash ^ node_name(
+			link,
+			parser)) * UINT64_C(0x9E3779B97F4A7C15);
+	}
+
+	return (uint32_t) (hash >> 32);
+}
+
+static bool chain_equal(
+uint32_t node1,
+uint32_t end1,
+uint32_t node2,
+uint32_t end2,
+const Parser* parser) {
+	while(node1 != end1
+	   && node2 != end2) {
+		const Node* link1 = parser_allocator_node(
+			parser,
+			node1);
+		const Node* link2 = parser_allocator_node(
+			parser,
+			node2);
+
+		if(link1->type != link2->type
+		|| link1->subtype != link2->subtype
+		|| node_name(
+			link1,
+			parser)
+		!= node_name(
+			link2,
+			parser))
+			return false;
+
+		node1 = link1->child1;
+		node2 = link2->child1;
+	}
+
+	return node1 == end1
+	    && node2 == end2;
+}
+
+static bool table_grow(ParserTypeTable* types) {
+	const ParserTypeSlot* const table_old = (const ParserTypeSlot*) types->table.addr;
+	const size_t count_old = types->table.count;
+	MemoryArea table;
+
+	if(create_memory_area(
+		count_old * 2,
+		sizeof(ParserTypeSlot),
+		&table)
+	== false)
+		return false;
+
+	const size_t mask = table.count - 1;
+
+	for(size_t i = 0;
+	i < count_old;
+	i += 1) {
+		if(table_old[i].node == 0)
+			continue;
+
+		size_t j = table_old[i].hash & mask;
+
+		while(((ParserTypeSlot*) table.addr)[j].node != 0) j = (j + 1) & mask;
+
+		((ParserTypeSlot*) table.addr)[j] = table_old[i];
+	}
+
+	destroy_memory_area(&types->table);
+	types->table = table;
+	return true;
+}
+
+// the slot of the equal chain, the empty one where it goes if none
+static size_t type_slot(
+uint32_t node,
+uint32_t end,
+uint32_t hash,
+const Parser* parser) {
+	const ParserTypeSlot* const table = (const ParserTypeSlot*) parser->types.table.addr;
+	const size_t mask = parser->types.table.count - 1;
+	size_t i = hash & mask;
+
+	for(;
+	table[i].node != 0;
+	i = (i + 1) & mask) {
+		if(table[i].hash == hash
+		&& chain_equal(
+			table[i].node,
+			table[i].end,
+			node,
+			end,
+			parser))
+			break;
+	}
+
+	return i;
+}
+
+static uint32_t type_intern(
+uint32_t node,
+uint32_t end,
+Parser* parser) {
+	ParserTypeTable* const types = &parser->types;
+
+	if(types->count_table * 2 >= types->table.count
+	&& table_grow(types) == false)
+		return 0;
+
+	ParserTypeSlot* const table = (ParserTypeSlot*) types->table.addr;
+	const uint32_t hash = chain_hash(
+		node,
+		end,
+		parser);
+	const size_t i = type_slot(
+		node,
+		end,
+		hash,
+		parser);
+
+	if(table[i].node != 0)
+		return table[i].node;
+
+	table[i] = (ParserTypeSlot) {
+		.hash = hash,
+		.node = node,
+		.end = end};
+	types->count_table += 1;
+	return node;
+}
+
+// the ID of a known type equal to the chain starting at `node`, 0 if none, the chain being left out of the table
+uint32_t parser_type_find(
+uint32_t node,
+const Parser* parser) {
+	assert(node != 0);
+	assert(parser != NULL);
+
+	return ((const ParserTypeSlot*) parser->types.table.addr)[type_slot(
+		node,
+		0,
+		chain_hash(
+			node,
+			0,
+			parser),
+		parser)].node;
+}
+
+/*
+ * the ID of the type whose chain starts at `node`, the chain itself if the type is new
+ * return 0 if the table cannot grow
+*/
+uint32_t parser_type_intern(
+uint32_t node,
+Parser* parser) {
+	assert(node != 0);
+	assert(parser != NULL);
+
+	return type_intern(
+		node,
+		0,
+		parser);
+}
+
+/*
+ * the ID of the part of a chain from `node` to `end` excluded, like the type of a parameter
+ * a part never equals a whole chain, which ends with its null link
+*/
+uint32_t parser_type_intern_part(
+uint32_t node,
+uint32_t end,
+Parser* parser) {
+	assert(node != 0);
+	assert(end != 0);
+	assert(parser != NULL);
+
+	return type_intern(
+		node,
+		end,
+		parser);
+}
+
+#undef CHUNK_TABLE
@@ -91,6 +91,62 @@ bool parser_is_lock(const Token* token) {
 	    && token->subtype == TokenSubtype_NO;
 }
 
+// the only construct an instruction can be by the type of its first token
+static const ParserConstruct lookahead_type[TokenType_LITERAL + 1] = {
+	[TokenType_COMMAND] = ParserConstruct_IDENTIFICATION,
+	[TokenType_QL] = ParserConstruct_IDENTIFICATION,
+	[TokenType_QR] = ParserConstruct_IDENTIFICATION,
+	[TokenType_QLR] = ParserConstruct_IDENTIFICATION};
+
+// and by the subtype of an L token
+static const ParserConstruct lookahead_L[TokenSubtype_IDENTIFIER + 1] = {
+	[TokenSubtype_NO] = ParserConstruct_CALL,
+	[TokenSubtype_MODULE_INPUT] = ParserConstruct_MODULE,
+	[TokenSubtype_MODULE_OUTPUT] = ParserConstruct_MODULE,
+	[TokenSubtype_SCOPE] = ParserConstruct_SCOPE};
+
+/*
+ * the construct is decided on its first tokens, so a failed attempt never creates nodes
+ * a scope is followed by its instructions, the other constructs by a period or a semicolon
+ * the first token gives one candidate through the tables, only its next tokens are checked
+*/
+ParserConstruct parser_lookahead(
+size_t i,
+const Parser* parser) {
+	const Token* tokens = (const Token*) parser->lexer->tokens.addr;
+	ParserConstruct construct = ParserConstruct_NO;
+
+	if(tokens[i].type == TokenType_L) {
+		if(tokens[i].subtype <= TokenSubtype_IDENTIFIER)
+			construct = lookahead_L[tokens[i].subtype];
+	} else if(tokens[i].type <= TokenType_LITERAL)
+		construct = lookahead_type[tokens[i].type];
+
+	switch(construct) {
+	case ParserConstruct_NO:
+	case ParserConstruct_SCOPE:
+		return construct;
+	case ParserConstruct_MODULE:
+		return tokens[i + 1].type == TokenType_L ? ParserConstruct_MODULE : ParserConstruct_NO;
+	case ParserConstruct_CALL:
+		// a key alone ending the instruction in a scope, like in `lab;`
+		return parser->count_scopes != 0
+		    && (tokens[i + 1].subtype == TokenSubtype_SEMICOLON
+		     || tokens[i + 1].subtype == TokenSubtype_PERIOD)
+		     ? ParserConstruct_CALL
+		     : ParserConstruct_NO;
+	case ParserConstruct_IDENTIFICATION:
+		while(parser_is_qualifier(tokens + i)) i += 1;
+
+		return parser_is_command(tokens + i)
+		    && tokens[i + 1].subtype == TokenSubtype_IDENTIFIER
+		     ? ParserConstruct_IDENTIFICATION
+		     : ParserConstruct_NO;
+	}
+
+	return ParserConstruct_NO;
+}
+
 bool parser_is_token_L_match(
 const char* code,
 const Token* token1,
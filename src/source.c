@@ -1,12 +1,90 @@
+#define _DEFAULT_SOURCE
 #include <assert.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "source.h"
 
+// below, reading the file is cheaper than mapping it
+#define LENGTH_SOURCE_MAPPING (64 * 1024)
+
 void initialize_source(Source* source) {
 	source->path = NULL;
 	source->content = NULL;
 	source->length = 0;
+	source->mapping = NULL;
+	source->length_mapping = 0;
+}
+
+/*
+ * the pages are reserved anonymously (so zeroed) and the file is mapped after the first one,
+ * the null character before the source being the last byte of the first page
+ * the end of the last page of the file is zeroed by the system, and the following pages are not replaced
+*/
+
+static bool map_source(
+int file,
+Source* source) {
+	const size_t size_page = (size_t) sysconf(_SC_PAGESIZE);
+	const size_t length = (size_t) source->length;
+	const size_t length_mapping = size_page + (length + 1 + SOURCE_PADDING + size_page - 1) / size_page * size_page;
+	char* const addr = mmap(
+		NULL,
+		length_mapping,
+		PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS,
+		-1,
+		0);
+
+	if(addr == MAP_FAILED)
+		return false;
+
+	if(mmap(
+		addr + size_page,
+		length,
+		PROT_READ | PROT_WRITE, // copy on write
+		MAP_PRIVATE | MAP_FIXED,
+		file,
+		0)
+	== MAP_FAILED) {
+		munmap(
+			addr,
+			length_mapping);
+		return false;
+	}
+
+	source->mapping = addr;
+	source->length_mapping = length_mapping;
+	source->content = addr + size_page - 1;
+	return true;
+}
+
+static bool read_source(
+FILE* source_file,
+Source* source) {
+	const size_t length = (size_t) source->length;
+	// get source as a string
+	source->content = malloc(length * sizeof(char) + 2 + SOURCE_PADDING);
+
+	if(source->content == NULL)
+		return false;
+
+	source->content[0] = '\0'; // will prevent errors with indexes
+	memset(
+		source->content + length + 1,
+		'\0',
+		1 + SOURCE_PADDING);
+
+	return fread(
+		source->content + 1,
+		1,
+		length,
+		source_file)
+	== length;
 }
 
 bool create_source(
@@ -35,22 +113,29 @@ Source* restrict source) {
 		0,
 		SEEK_SET);
 
-	if(ferror(source_file) != 0)
+	if(ferror(source_file) != 0
+	|| source->length < 0)
 		goto CLOSE;
-	// get source as a string
-	source->content = malloc(source->length * sizeof(char) + 2);
 
-	if(source->content == NULL)
-		goto CLOSE;
+	struct stat status;
 
-	source->content[0] = '\0'; // will prevent errors with indexes
+	if(source->length >= LENGTH_SOURCE_MAPPING
+	&& fstat(
+		fileno(source_file),
+		&status)
+	== 0
+	&& S_ISREG(status.st_mode)
+	&& map_source(
+		fileno(source_file),
+		source)) {
+		error = false;
+		goto CLOSE;
+	}
 
-	if(fread(
-		source->content + 1,
-		1,
-		source->length,
-		source_file)
-	!= (size_t) source->length)
+	if(read_source(
+		source_file,
+		source)
+	== false)
 		goto CLOSE;
 
 	error = false;
@@ -61,7 +146,6 @@ CLOSE:
 	if(error)
 		goto ERROR;
 
-	source->content[(size_t) source->length + 1] = '\0';
 	return true;
 ERROR:
 	destroy_source(source);
@@ -72,6 +156,14 @@ void destroy_source(Source* source) {
 	if(source == NULL)
 		return;
 
-	free(source->content);
+	if(source->mapping != NULL)
+		munmap(
+			source->mapping,
+			source->length_mapping);
+	else
+		free(source->content);
+
 	initialize_source(source);
 }
+
+#undef LENGTH_SOURCE_MAPPING
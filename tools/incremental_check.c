@@ -0,0 +1,516 @@
+#define _POSIX_C_SOURCE 200809L
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "kel.h"
+#include "parser_allocator.h"
+#include "parser_incremental.h"
+
+/*
+ * the AST of an incremental parse after token edits must be the one of `create_parser` on the edited source:
+ * "incremental_check", each case replaces a part of the same source, the edits being the tokens out of
+ * their longest common subsequence, and checks whether the previous parse is used before comparing
+ * the nodes, the symbols, the signatures and the qualifiers
+ * the error of the lexer being global, every source of a case must be tokenized
+*/
+
+#define PATH_BEFORE "/tmp/kel_incremental_check_before.kl"
+#define PATH_AFTER "/tmp/kel_incremental_check_after.kl"
+#define PATH_CACHE "/tmp/kel_incremental_check_XXXXXX"
+#define COUNT_EDITS 16
+
+// how the previous parse is made
+typedef enum: uint8_t {
+#define CHECK_PREVIOUS(type) CheckPrevious_ ## type
+	CHECK_PREVIOUS(PARSED) = 0,
+	CHECK_PREVIOUS(CACHED), // loaded from the AST file, without instructions
+	CHECK_PREVIOUS(UNRESOLVED), // its calls left in the fixups
+	CHECK_PREVIOUS(INVALID), // parsed, but the edits overlap
+#undef CHECK_PREVIOUS
+} CheckPrevious;
+
+typedef struct {
+	const char* name;
+	const char* old; // replaced in the source, null for no edit
+	const char* new;
+	CheckPrevious previous;
+	int status; // expected of `parser_incremental_create`, 0 if the previous parse is not used
+} CheckCase;
+
+// shared types, forward calls, qualifiers on their side, a key and a call in scopes
+static const char source[] =
+	"imod sys, io.file;\n"
+	"@var1:u32 1;\n"
+	"@var2 :u32 0x1F;\n"
+	"[mut] @var3 :u32;\n"
+	"[pub] @var4 :u32 var1 + tail(var2, 3);\n"
+	"@lab_x :B(x :A);\n"
+	"#lab1 :scope;\n"
+	"[entry] #main :scope;\n"
+	"#lab2 :scope scope\n"
+	"\t@inner :u32 0B101;\n"
+	"\t@c :chr 'a';\n"
+	"\tlab1;\n"
+	".\n"
+	"@lab3 :(a :A, b :B(), c :B(:(:A)));\n"
+	"#lab5 :B(a :A) scope\n"
+	"\t@x :u32 0o17;\n"
+	"\t@y :u32 1`000`000 + var2;\n"
+	".\n"
+	"#tail :B(c :A, d :A) scope\n"
+	"\t@q :u32 lab5(c) + d.\n";
+
+static const CheckCase cases[] = {
+	{"no edit", NULL, NULL, CheckPrevious_PARSED, 1},
+	{"initializer", "@var2 :u32 0x1F;", "@var2 :u32 0x2F + var1;", CheckPrevious_PARSED, 1},
+	{"insertion in a scope", "\t@c :chr 'a';\n", "\t@c :chr 'a';\n\t@d :u32 var3;\n", CheckPrevious_PARSED, 1},
+	{"insertion", "#lab1 :scope;\n", "#lab1 :scope;\n[mut] @new :u32 7;\n", CheckPrevious_PARSED, 1},
+	{"deletion", "[mut] @var3 :u32;\n", "", CheckPrevious_PARSED, 1},
+	// every instruction of type `u32` shares the one of `var1`
+	{"shared type", "@var1:u32 1;", "@var1:u32 2;", CheckPrevious_PARSED, 1},
+	// the keys to `var2` of the copied instructions are looked up again, `lab2` shares its new type
+	{"declaration referred to", "@var2 :u32 0x1F;", "@var2 :chr 'b';", CheckPrevious_PARSED, 1},
+	{"signature", "#lab5 :B(a :A) scope\n\t@x :u32 0o17;\n\t@y :u32 1`000`000 + var2;\n.\n#tail :B(c :A, d :A) scope\n\t@q :u32 lab5(c) + d.\n",
+		"#lab5 :B(a :A, b :A) scope\n\t@x :u32 0o17;\n\t@y :u32 1`000`000 + var2;\n.\n#tail :B(c :A, d :A) scope\n\t@q :u32 lab5(c, d) + d.\n",
+		CheckPrevious_PARSED, 1},
+	{"both ends", "imod sys, io.file;", "imod sys;", CheckPrevious_PARSED, 1},
+	{"cached", "@var2 :u32 0x1F;", "@var2 :u32 0x2F + var1;", CheckPrevious_CACHED, 0},
+	{"unresolved", "@var2 :u32 0x1F;", "@var2 :u32 0x2F + var1;", CheckPrevious_UNRESOLVED, 0},
+	{"invalid edit", "@var2 :u32 0x1F;", "@var2 :u32 0x2F + var1;", CheckPrevious_INVALID, 0},
+	// `lab1` up to `lab2` in the scope of `lab_x`, the copied `lab1` starting in it, the edits not touching it
+	{"open scope", "@lab_x :B(x :A);\n#lab1 :scope;\n[entry] #main :scope;\n#lab2 :scope scope\n\t@inner :u32 0B101;\n\t@c :chr 'a';\n\tlab1;\n",
+		"#lab_x :B(x :A) scope\n\t@w :u32 1;\n#lab1 :scope;\n[entry] #main :scope;\n#lab2 :scope scope\n\t@inner :u32 0B101;\n\t@c :chr 'a';\n\tlab1.\n",
+		CheckPrevious_PARSED, 0},
+};
+
+typedef struct {
+	Source source;
+	MemoryArea memArea;
+	Lexer lexer;
+} CheckLexing;
+
+static bool write_source(
+const char* path,
+const CheckCase* check,
+bool is_after) {
+	FILE* file = fopen(
+		path,
+		"w");
+
+	if(file == NULL)
+		return false;
+
+	const char* replaced = check->old != NULL ? strstr(source, check->old) : NULL;
+
+	if(!is_after
+	|| replaced == NULL)
+		fputs(source, file);
+	else {
+		fwrite(source, sizeof(char), (size_t) (replaced - source), file);
+		fputs(check->new, file);
+		fputs(replaced + strlen(check->old), file);
+	}
+
+	return fclose(file) == 0;
+}
+
+static bool lex(
+const char* path,
+Interner* interner,
+CheckLexing* lexing) {
+	return create_source(path, &lexing->source)
+	    && create_memory_area((size_t) lexing->source.length, sizeof(uint8_t), &lexing->memArea)
+	    && create_lexer(&lexing->source, interner, &lexing->memArea, &lexing->lexer);
+}
+
+// the same kind and the same characters up to the next token
+static bool is_same_token(
+const CheckLexing* lexing1,
+size_t i1,
+const CheckLexing* lexing2,
+size_t i2) {
+	const Token* tokens1 = (const Token*) lexing1->lexer.tokens.addr;
+	const Token* tokens2 = (const Token*) lexing2->lexer.tokens.addr;
+	// the last token of `create_lexer` is the null one
+	const long int end1 = i1 + 2 < lexing1->lexer.tokens.count ? tokens1[i1 + 1].start : lexing1->source.length;
+	const long int end2 = i2 + 2 < lexing2->lexer.tokens.count ? tokens2[i2 + 1].start : lexing2->source.length;
+	return tokens1[i1].type == tokens2[i2].type
+	    && tokens1[i1].subtype == tokens2[i2].subtype
+	    && end1 - tokens1[i1].start == end2 - tokens2[i2].start
+	    && memcmp(
+		lexing1->source.content + tokens1[i1].start,
+		lexing2->source.content + tokens2[i2].start,
+		(size_t) (end1 - tokens1[i1].start))
+	    == 0;
+}
+
+/*
+ * the tokens of the previous lexing out of the longest common subsequence are replaced, in the order of the file
+ * return the number of edits, -1 if they do not fit
+*/
+static long int find_edits(
+const CheckLexing* before,
+const CheckLexing* after,
+ParserEdit* edits) {
+	const size_t count1 = before->lexer.tokens.count - 1;
+	const size_t count2 = after->lexer.tokens.count - 1;
+	const size_t width = count2 + 1;
+	// the length of the subsequence from each pair of tokens to the end
+	uint32_t* lengths = calloc(
+		(count1 + 1) * width,
+		sizeof(uint32_t));
+
+	if(lengths == NULL)
+		return -1;
+
+	for(size_t i = count1;
+	i-- > 1;) {
+		for(size_t j = count2;
+		j-- > 1;) lengths[i * width + j] = is_same_token(
+				before,
+				i,
+				after,
+				j)
+			? lengths[(i + 1) * width + j + 1] + 1
+			: lengths[(i + 1) * width + j] > lengths[i * width + j + 1]
+			 ? lengths[(i + 1) * width + j]
+			 : lengths[i * width + j + 1];
+	}
+
+	long int count_edits = 0;
+	size_t i = 1;
+	size_t j = 1;
+
+	while(i < count1
+	   || j < count2) {
+		if(i < count1
+		&& j < count2
+		&& is_same_token(
+			before,
+			i,
+			after,
+			j)) {
+			i += 1;
+			j += 1;
+			continue;
+		}
+
+		if(count_edits == COUNT_EDITS) {
+			count_edits = -1;
+			break;
+		}
+		// up to the next token of the subsequence
+		const size_t start = i;
+		const size_t start_new = j;
+
+		while((i < count1
+		    || j < count2)
+		   && !(i < count1
+		    && j < count2
+		    && is_same_token(
+			before,
+			i,
+			after,
+			j))) {
+			if(j == count2
+			|| (i < count1
+			 && lengths[(i + 1) * width + j] >= lengths[i * width + j + 1]))
+				i += 1;
+			else
+				j += 1;
+		}
+
+		edits[count_edits] = (ParserEdit) {
+			.start = start,
+			.end_old = i,
+			.end_new = start + j - start_new};
+		count_edits += 1;
+	}
+
+	free(lengths);
+	return count_edits;
+}
+
+static void remove_cache(const char* path) {
+	DIR* directory = opendir(path);
+
+	if(directory != NULL) {
+		char path_file[4096];
+
+		for(struct dirent* entry = readdir(directory);
+		entry != NULL;
+		entry = readdir(directory)) {
+			if(entry->d_name[0] != '.'
+			&& snprintf(path_file, sizeof(path_file), "%s/%s", path, entry->d_name) < (int) sizeof(path_file))
+				unlink(path_file);
+		}
+
+		closedir(directory);
+	}
+
+	rmdir(path);
+}
+
+// the parse of the file a second time being the one of its AST file
+static bool parse_cached(
+const Lexer* lexer,
+Parser* parser) {
+	char path[] = PATH_CACHE;
+
+	if(mkdtemp(path) == NULL)
+		return false;
+
+	setenv("KEL_CACHE", path, 1);
+	bool is_loaded = create_parser(
+		lexer,
+		parser);
+
+	if(is_loaded) {
+		destroy_parser(parser);
+		is_loaded = create_parser(
+			lexer,
+			parser)
+		         && parser->count_tops == 0;
+	}
+
+	unsetenv("KEL_CACHE");
+	remove_cache(path);
+	return is_loaded;
+}
+
+static bool parse_previous(
+CheckPrevious previous,
+const Lexer* lexer,
+Parser* parser) {
+	parser->lexer = lexer;
+
+	switch(previous) {
+	case CheckPrevious_CACHED:
+		return parse_cached(
+			lexer,
+			parser);
+	case CheckPrevious_UNRESOLVED:
+		return parser_create_allocators(parser)
+		    && parser_parse_tokens(
+			1,
+			lexer->tokens.count - 1,
+			parser)
+		    && parser->count_fixups != 0;
+	default:
+		return create_parser(
+			lexer,
+			parser);
+	}
+}
+
+static bool is_same_area(
+const MemoryArea* area1,
+size_t count1,
+const MemoryArea* area2,
+size_t count2,
+size_t size) {
+	return count1 == count2
+	    && (count1 == 0
+	     || memcmp(
+		area1->addr,
+		area2->addr,
+		count1 * size)
+	     == 0);
+}
+
+// the signatures field by field, their padding being left as is
+static bool is_same_signatures(
+const ParserSignatureTable* signatures1,
+const ParserSignatureTable* signatures2) {
+	if(signatures1->count_signatures != signatures2->count_signatures
+	|| !is_same_area(
+		&signatures1->parameters,
+		signatures1->count_parameters,
+		&signatures2->parameters,
+		signatures2->count_parameters,
+		sizeof(uint32_t)))
+		return false;
+
+	const ParserSignature* list1 = (const ParserSignature*) signatures1->signatures.addr;
+	const ParserSignature* list2 = (const ParserSignature*) signatures2->signatures.addr;
+
+	for(size_t i = 0;
+	i < signatures1->count_signatures;
+	i += 1) {
+		if(list1[i].node != list2[i].node
+		|| list1[i].type_return != list2[i].type_return
+		|| list1[i].parameters != list2[i].parameters
+		|| list1[i].count_parameters != list2[i].count_parameters
+		|| list1[i].command != list2[i].command)
+			return false;
+	}
+
+	return true;
+}
+
+// the first part of the AST which differs, null if none
+static const char* compare(
+const Parser* incremental,
+const Parser* full) {
+	if(!is_same_area(
+		&incremental->nodes,
+		incremental->count_nodes,
+		&full->nodes,
+		full->count_nodes,
+		sizeof(Node)))
+		return "nodes";
+
+	if(!is_same_area(
+		&incremental->symbols.symbols,
+		incremental->symbols.count_symbols,
+		&full->symbols.symbols,
+		full->symbols.count_symbols,
+		sizeof(ParserSymbol)))
+		return "symbols";
+
+	if(!is_same_signatures(
+		&incremental->signatures,
+		&full->signatures))
+		return "signatures";
+
+	if(!is_same_area(
+		&incremental->qualifiers.qualifiers,
+		incremental->qualifiers.count_qualifiers,
+		&full->qualifiers.qualifiers,
+		full->qualifiers.count_qualifiers,
+		sizeof(ParserQualifier)))
+		return "qualifiers";
+
+	return NULL;
+}
+
+static bool check(const CheckCase* check) {
+	Interner interner;
+	CheckLexing before;
+	CheckLexing after;
+	Parser previous;
+	Parser scratch;
+	Parser incremental;
+	Parser full;
+	initialize_interner(&interner);
+	initialize_source(&before.source);
+	initialize_memory_area(&before.memArea);
+	initialize_lexer(&before.lexer);
+	initialize_source(&after.source);
+	initialize_memory_area(&after.memArea);
+	initialize_lexer(&after.lexer);
+	initialize_parser(&previous);
+	initialize_parser(&scratch);
+	initialize_parser(&incremental);
+	initialize_parser(&full);
+	ParserEdit edits[COUNT_EDITS];
+	bool is_same = false;
+
+	if(!write_source(PATH_BEFORE, check, false)
+	|| !write_source(PATH_AFTER, check, true)
+	|| !create_interner(CAPACITY_INTERNER, &interner)
+	|| !lex(PATH_BEFORE, &interner, &before)
+	|| !lex(PATH_AFTER, &interner, &after)) {
+		fprintf(stderr, "%s: cannot be tokenized\n", check->name);
+		goto END;
+	}
+
+	long int count_edits = find_edits(
+		&before,
+		&after,
+		edits);
+
+	if(count_edits < 0) {
+		fprintf(stderr, "%s: too many edits\n", check->name);
+		goto END;
+	}
+
+	if(!parse_previous(
+		check->previous,
+		&before.lexer,
+		&previous)) {
+		fprintf(stderr, "%s: the previous parse cannot be made\n", check->name);
+		goto END;
+	}
+	// the end of the first edit before its start
+	if(check->previous == CheckPrevious_INVALID) {
+		if(count_edits == 0)
+			goto END;
+
+		edits[0].end_old = edits[0].start - 1;
+		edits[0].end_new = edits[0].start - 1;
+	}
+
+	scratch.lexer = &after.lexer;
+	const int status = parser_incremental_create(
+		&previous,
+		edits,
+		(size_t) count_edits,
+		&scratch);
+	destroy_parser(&scratch);
+
+	if(!create_parser_incremental(
+		&after.lexer,
+		&previous,
+		edits,
+		(size_t) count_edits,
+		&incremental)
+	|| !create_parser(
+		&after.lexer,
+		&full)) {
+		fprintf(stderr, "%s: cannot be parsed\n", check->name);
+		goto END;
+	}
+
+	const char* part = compare(
+		&incremental,
+		&full);
+	is_same = status == check->status
+	       && part == NULL;
+	printf(
+		"%s: %ld edits, %s, %zu nodes: %s%s%s%s\n",
+		check->name,
+		count_edits,
+		status == 1 ? "previous parse used" : status == 0 ? "parsed again" : "failed",
+		incremental.count_nodes,
+		is_same ? "same" : "DIFFERENT",
+		status != check->status ? ", unexpected status" : "",
+		part != NULL ? ", other " : "",
+		part != NULL ? part : "");
+END:
+	destroy_parser(&full);
+	destroy_parser(&incremental);
+	destroy_parser(&previous);
+	destroy_lexer(&after.lexer);
+	destroy_memory_area(&after.memArea);
+	destroy_source(&after.source);
+	destroy_lexer(&before.lexer);
+	destroy_memory_area(&before.memArea);
+	destroy_source(&before.source);
+	destroy_interner(&interner);
+	return is_same;
+}
+
+int main(void) {
+	// the previous parse is only loaded from its AST file by its case
+	unsetenv("KEL_CACHE");
+	bool is_same = true;
+
+	for(size_t i = 0;
+	i < sizeof(cases) / sizeof(*cases);
+	i += 1) {
+		if(!check(cases + i))
+			is_same = false;
+	}
+
+	remove(PATH_BEFORE);
+	remove(PATH_AFTER);
+	return is_same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#undef COUNT_EDITS
+#undef PATH_CACHE
+#undef PATH_AFTER
+#undef PATH_BEFORE
@@ -0,0 +1,170 @@
+#define _POSIX_C_SOURCE 200809L
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "interner.h"
+
+/*
+ * scaling of `interner_intern` from 1 to N threads: "interner_bench [N] [count]"
+ * every thread interns the same shared names (found after the first insertion)
+ * and as many names of its own (always inserted), like lexers of modules sharing identifiers
+*/
+
+#define LENGTH_NAME 24
+
+typedef struct {
+	Interner* interner;
+	size_t thread;
+	size_t count;
+	uint32_t* ids; // of the shared names
+	bool error;
+} Worker;
+
+// FNV-1a like `lexer_hash`
+static uint64_t hash(
+const char* string,
+size_t length) {
+	uint64_t hash = 0xCBF29CE484222325;
+
+	for(size_t i = 0;
+	i < length;
+	i += 1) {
+		hash ^= (uint8_t) string[i];
+		hash *= 0x100000001B3;
+	}
+
+	return hash;
+}
+
+static void* work(void* argument) {
+	Worker* const worker = argument;
+	char name[LENGTH_NAME];
+
+	for(size_t i = 0;
+	i < worker->count;
+	i += 1) {
+		// shared then own name
+		int length = snprintf(
+			name,
+			LENGTH_NAME,
+			"shared_%zu",
+			i);
+		worker->ids[i] = interner_intern(
+			name,
+			(size_t) length,
+			hash(name, (size_t) length),
+			worker->interner);
+		length = snprintf(
+			name,
+			LENGTH_NAME,
+			"own_%zu_%zu",
+			worker->thread,
+			i);
+
+		if(worker->ids[i] == 0
+		|| interner_intern(
+			name,
+			(size_t) length,
+			hash(name, (size_t) length),
+			worker->interner)
+		== 0)
+			worker->error = true;
+	}
+
+	return NULL;
+}
+
+static double seconds(void) {
+	struct timespec time;
+	clock_gettime(
+		CLOCK_MONOTONIC,
+		&time);
+	return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+int main(
+int argc,
+char** argv) {
+	const size_t count_thread = argc > 1 ? strtoul(argv[1], NULL, 10) : 8;
+	const size_t count = argc > 2 ? strtoul(argv[2], NULL, 10) : 200000;
+
+	if(count_thread == 0
+	|| count == 0) {
+		fprintf(stderr, "usage: %s [threads] [names per thread]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	printf("threads\tseconds\tinterns/s\n");
+
+	for(size_t n = 1;
+	n <= count_thread;
+	n += 1) {
+		Interner interner;
+		pthread_t threads[n];
+		Worker workers[n];
+		initialize_interner(&interner);
+
+		if(create_interner(
+			count * (n + 1),
+			&interner)
+		== false)
+			return EXIT_FAILURE;
+
+		for(size_t t = 0;
+		t < n;
+		t += 1) {
+			workers[t] = (Worker) {
+				.interner = &interner,
+				.thread = t,
+				.count = count,
+				.ids = malloc(count * sizeof(uint32_t)),
+				.error = false};
+
+			if(workers[t].ids == NULL)
+				return EXIT_FAILURE;
+		}
+
+		const double start = seconds();
+
+		for(size_t t = 0;
+		t < n;
+		t += 1) pthread_create(threads + t, NULL, work, workers + t);
+
+		for(size_t t = 0;
+		t < n;
+		t += 1) pthread_join(threads[t], NULL);
+
+		const double time = seconds() - start;
+		// the threads must agree on the IDs
+		for(size_t t = 0;
+		t < n;
+		t += 1) {
+			for(size_t i = 0;
+			i < count;
+			i += 1) {
+				if(workers[t].error
+				|| workers[t].ids[i] != workers[0].ids[i]) {
+					fprintf(stderr, "IDs differ between threads\n");
+					return EXIT_FAILURE;
+				}
+			}
+		}
+
+		for(size_t t = 0;
+		t < n;
+		t += 1) free(workers[t].ids);
+
+		printf(
+			"%zu\t%.3f\t%.0f\n",
+			n,
+			time,
+			(double) (2 * count * n) / time);
+		destroy_interner(&interner);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#undef LENGTH_NAME
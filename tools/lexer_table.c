@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <string.h>
+#include "lexer_def.h"
+#include "lexer_table.h"
+
+/*
+ * generates the tables of "lexer_table.h"
+ * the grammar of the characters is only described here
+*/
+
+#define SPECIAL_INTERPRETED "!\"#%&'()*+,-./;<=>?@[\\]^`{|}~"
+#define COMMAND "!#@"
+#define OPERATOR_LEVELING "&+-|"
+#define BRACKET "[]"
+#define PARENTHESIS "()"
+#define DELIMITER_OPEN "([{"
+#define DELIMITER_CLOSE ")]}"
+#define COLON_VALID_LEFT "#&()+-@]|"
+#define COLON_VALID_RIGHT "#&(+-@[`|"
+
+static const char subtypes[] = "!\"#%&'()*+,-./:;<=>?@[]\\^`{|}~";
+static const TokenSubtype subtypes_token[] = {
+	TokenSubtype_EXCLAMATION_MARK,
+	TokenSubtype_DQUOTES,
+	TokenSubtype_HASH,
+	TokenSubtype_MODULO,
+	TokenSubtype_AMPERSAND,
+	TokenSubtype_SQUOTE,
+	TokenSubtype_LPARENTHESIS,
+	TokenSubtype_RPARENTHESIS,
+	TokenSubtype_ASTERISK,
+	TokenSubtype_PLUS,
+	TokenSubtype_COMMA,
+	TokenSubtype_MINUS,
+	TokenSubtype_PERIOD,
+	TokenSubtype_DIVIDE,
+	TokenSubtype_COLON,
+	TokenSubtype_SEMICOLON,
+	TokenSubtype_LOBRACKET,
+	TokenSubtype_EQUAL,
+	TokenSubtype_ROBRACKET,
+	TokenSubtype_QUESTION_MARK,
+	TokenSubtype_AT,
+	TokenSubtype_LBRACKET,
+	TokenSubtype_RBRACKET,
+	TokenSubtype_BACKSLASH,
+	TokenSubtype_CARET,
+	TokenSubtype_GRAVE_ACCENT,
+	TokenSubtype_LCBRACE,
+	TokenSubtype_PIPE,
+	TokenSubtype_RCBRACE,
+	TokenSubtype_TILDE};
+
+static bool is_in(
+int c,
+const char* set) {
+	return c != '\0'
+	    && strchr(
+			set,
+			c)
+		!= NULL;
+}
+// the "C" locale is used so that the tables do not depend on the environment
+static bool is_graph(int c) {
+	return c > ' '
+	    && c < 0x7F;
+}
+
+static bool is_alpha(int c) {
+	return (c >= 'a'
+	     && c <= 'z')
+	    || (c >= 'A'
+	     && c <= 'Z');
+}
+
+static bool is_digit(int c) {
+	return c >= '0'
+	    && c <= '9';
+}
+
+static uint16_t get_classes(int c) {
+	uint16_t classes = 0;
+
+	if(is_graph(c)) classes |= LexerClass_GRAPH;
+	if(is_alpha(c)) classes |= LexerClass_ALPHA;
+	if(is_digit(c)) classes |= LexerClass_DIGIT;
+	if(is_digit(c) || (c >= 'A' && c <= 'F')) classes |= LexerClass_XDIGIT;
+	if(is_alpha(c) || is_digit(c) || c == '_') classes |= LexerClass_NAME;
+	if(is_in(c, SPECIAL_INTERPRETED) || c == ':') classes |= LexerClass_SPECIAL;
+	if(is_in(c, SPECIAL_INTERPRETED)) classes |= LexerClass_INTERPRETED;
+	if(is_in(c, COMMAND)) classes |= LexerClass_COMMAND;
+	if(is_in(c, OPERATOR_LEVELING)) classes |= LexerClass_OPERATOR_LEVELING;
+	if(is_in(c, BRACKET)) classes |= LexerClass_BRACKET;
+	if(is_in(c, PARENTHESIS)) classes |= LexerClass_PARENTHESIS;
+	if(is_in(c, DELIMITER_OPEN)) classes |= LexerClass_DELIMITER_OPEN;
+	if(is_in(c, DELIMITER_CLOSE)) classes |= LexerClass_DELIMITER_CLOSE;
+	if((classes & LexerClass_SPECIAL) && !is_in(c, COLON_VALID_LEFT)) classes |= LexerClass_COLON_INVALID_LEFT;
+	if((classes & LexerClass_SPECIAL) && !is_in(c, COLON_VALID_RIGHT)) classes |= LexerClass_COLON_INVALID_RIGHT;
+	if(c == '\0') classes |= LexerClass_COLON_INVALID_RIGHT;
+
+	return classes;
+}
+
+static LexerEquivalence get_equivalence(int c) {
+	if(c == '\0') return LexerEquivalence_NULL;
+	if(!is_graph(c)) return LexerEquivalence_BLANK;
+	if(is_alpha(c)) return LexerEquivalence_ALPHA;
+	if(is_digit(c)) return LexerEquivalence_DIGIT;
+	if(c == ':') return LexerEquivalence_COLON;
+	if(c == '.') return LexerEquivalence_PERIOD;
+	if(c == '[') return LexerEquivalence_LBRACKET;
+	if(is_in(c, COMMAND)) return LexerEquivalence_COMMAND;
+	if(c == '\'' || c == '`') return LexerEquivalence_QUOTE;
+	if(is_in(c, SPECIAL_INTERPRETED)) return LexerEquivalence_SPECIAL;
+	return LexerEquivalence_GRAPH;
+}
+// rules which may succeed for a word beginning with `first` followed by `second`
+static uint16_t get_rules(
+LexerEquivalence first,
+LexerEquivalence second) {
+	uint16_t rules = 0;
+
+	switch(first) {
+	case LexerEquivalence_COMMAND:
+		rules |= LexerRule_COMMAND | LexerRule_SPECIAL;
+		break;
+	case LexerEquivalence_LBRACKET:
+		rules |= LexerRule_QL | LexerRule_QLR | LexerRule_SPECIAL;
+		break;
+	case LexerEquivalence_ALPHA:
+		// R after a modifier operator
+		rules |= LexerRule_L | LexerRule_R | LexerRule_LR | LexerRule_NAME;
+		break;
+	case LexerEquivalence_COLON:
+		if(second == LexerEquivalence_LBRACKET)
+			rules |= LexerRule_QR;
+		else if(second == LexerEquivalence_ALPHA)
+			rules |= LexerRule_R;
+
+		rules |= LexerRule_SPECIAL;
+		break;
+	case LexerEquivalence_PERIOD:
+		// the period is right blank-sensitive
+		if(second != LexerEquivalence_NULL
+		&& second != LexerEquivalence_BLANK)
+			rules |= LexerRule_PL;
+
+		rules |= LexerRule_SPECIAL;
+		break;
+	case LexerEquivalence_DIGIT:
+		rules |= LexerRule_LITERAL;
+		break;
+	case LexerEquivalence_QUOTE:
+		rules |= LexerRule_LITERAL | LexerRule_SPECIAL;
+		break;
+	case LexerEquivalence_SPECIAL:
+		rules |= LexerRule_SPECIAL;
+		break;
+	default:
+		break;
+	}
+
+	return rules;
+}
+
+static void print_table(
+const char* declaration,
+const unsigned* values,
+size_t count) {
+	printf("%s = {", declaration);
+
+	for(size_t i = 0;
+	i < count;
+	i += 1) {
+		printf(
+			"%s0x%X",
+			i % 16 == 0 ? "\n\t" : " ",
+			values[i]);
+
+		if(i != count - 1)
+			printf(",");
+	}
+
+	printf("};\n\n");
+}
+
+int main(void) {
+	unsigned values[256];
+	printf("// generated by \"tools/lexer_table.c\", do not edit\n\n");
+
+	for(int c = 0; c < 256; c += 1) values[c] = get_classes(c);
+
+	print_table(
+		"const uint16_t lexer_classes[256]",
+		values,
+		256);
+
+	for(int c = 0; c < 256; c += 1) values[c] = get_equivalence(c);
+
+	print_table(
+		"const uint8_t lexer_equivalences[256]",
+		values,
+		256);
+
+	for(int c = 0; c < 256; c += 1) {
+		const char* subtype = is_in(c, subtypes) ? strchr(subtypes, c) : NULL;
+		values[c] = subtype != NULL ? subtypes_token[subtype - subtypes] : TokenSubtype_NO;
+	}
+
+	print_table(
+		"const uint8_t lexer_subtypes[256]",
+		values,
+		256);
+	printf("const uint16_t lexer_rules[LexerEquivalence_COUNT][LexerEquivalence_COUNT] = {");
+
+	for(int first = 0; first < LexerEquivalence_COUNT; first += 1) {
+		printf("\n\t{");
+
+		for(int second = 0; second < LexerEquivalence_COUNT; second += 1) {
+			printf(
+				"0x%X%s",
+				get_rules(first, second),
+				second != LexerEquivalence_COUNT - 1 ? ", " : "");
+		}
+
+		printf("}%s", first != LexerEquivalence_COUNT - 1 ? "," : "");
+	}
+
+	printf("};\n");
+	return 0;
+}
+
+#undef COLON_VALID_RIGHT
+#undef COLON_VALID_LEFT
+#undef DELIMITER_CLOSE
+#undef DELIMITER_OPEN
+#undef PARENTHESIS
+#undef BRACKET
+#undef OPERATOR_LEVELING
+#undef COMMAND
+#undef SPECIAL_INTERPRETED
@@ -0,0 +1,152 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kel.h"
+#include "parser_allocator.h"
+#include "parser_call.h"
+#include "parser_parallel.h"
+
+/*
+ * the nodes of a file parsed by several threads must be the ones of a parse in one pass:
+ * "parallel_check [file...]", a generated source without file
+ * built with `PARSER_PARALLEL_MIN_TOKENS` set to 1 so that any file is cut in units
+*/
+
+#define PATH_SOURCE "/tmp/kel_parallel_check.kl"
+#define COUNT_GROUP 2000
+
+// the same types in every unit, calls of labels identified later
+static bool write_source(void) {
+	FILE* file = fopen(
+		PATH_SOURCE,
+		"w");
+
+	if(file == NULL)
+		return false;
+
+	fprintf(file, "imod sys, io.file;\n");
+
+	for(size_t i = 0;
+	i < COUNT_GROUP;
+	i += 1) fprintf(
+		file,
+		"@v%zu :u32 %zu;\n"
+		"[mut] @w%zu :u32 v%zu + p%zu(v%zu, 2);\n"
+		"#p%zu :B(c :A, d :A) scope\n"
+		"\t@q :u32 p%zu(c, d) + c;\n"
+		".\n"
+		"#l%zu :scope scope\n"
+		"\t@y :u32 v%zu;\n"
+		"\tscope\n"
+		"\t\tl%zu;\n"
+		"\t.\n"
+		"\tl%zu.\n",
+		i,
+		i + 1,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i);
+
+	return fclose(file) == 0;
+}
+
+static bool parse_serial(Parser* parser) {
+	return parser_create_allocators(parser)
+	    && parser_parse_tokens(
+		1,
+		parser->lexer->tokens.count - 1,
+		parser)
+	    && parser_call_resolve(parser);
+}
+
+static bool parse_parallel(Parser* parser) {
+	return parser_parallel_create(parser) == 1
+	    && parser_call_resolve(parser);
+}
+
+// return 0 if the nodes differ, -1 if the file cannot be parsed
+static int check(const char* path) {
+	Source source;
+	MemoryArea memArea;
+	Interner interner;
+	Lexer lexer;
+	Parser serial;
+	Parser parallel;
+	initialize_source(&source);
+	initialize_memory_area(&memArea);
+	initialize_interner(&interner);
+	initialize_lexer(&lexer);
+	initialize_parser(&serial);
+	initialize_parser(&parallel);
+	serial.lexer = &lexer;
+	parallel.lexer = &lexer;
+	int status = -1;
+
+	if(!create_source(path, &source)
+	|| !create_memory_area((size_t) source.length, sizeof(uint8_t), &memArea)
+	|| !create_interner(CAPACITY_INTERNER, &interner)
+	|| !create_lexer(&source, &interner, &memArea, &lexer)
+	|| !parse_serial(&serial)
+	|| !parse_parallel(&parallel)) {
+		fprintf(stderr, "%s: cannot be parsed\n", path);
+		goto END;
+	}
+
+	status = serial.count_nodes == parallel.count_nodes
+	      && memcmp(
+		serial.nodes.addr,
+		parallel.nodes.addr,
+		serial.count_nodes * sizeof(Node))
+	      == 0;
+	printf(
+		"%s: %zu tokens, %zu nodes in one pass, %zu by the threads: %s\n",
+		path,
+		lexer.tokens.count,
+		serial.count_nodes,
+		parallel.count_nodes,
+		status == 1 ? "same" : "DIFFERENT");
+END:
+	destroy_parser(&parallel);
+	destroy_parser(&serial);
+	destroy_lexer(&lexer);
+	destroy_interner(&interner);
+	destroy_memory_area(&memArea);
+	destroy_source(&source);
+	return status;
+}
+
+int main(
+int argc,
+char** argv) {
+	bool is_same = true;
+
+	if(argc < 2) {
+		if(!write_source()) {
+			fprintf(stderr, "cannot write %s\n", PATH_SOURCE);
+			return EXIT_FAILURE;
+		}
+
+		is_same = check(PATH_SOURCE) == 1;
+		remove(PATH_SOURCE);
+	}
+
+	for(int i = 1;
+	i < argc;
+	i += 1) {
+		if(check(argv[i]) != 1)
+			is_same = false;
+	}
+
+	return is_same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#undef COUNT_GROUP
+#undef PATH_SOURCE
@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "kel.h"
+
+/*
+ * time of `create_parser` on nested scopes holding one declaration each: "scope_bench [depth]"
+ * the depth is doubled from 1000, a linear parser keeps the time per scope constant
+ * without the token and AST caches
+*/
+
+#define PATH_SOURCE "/tmp/kel_scope_bench.kl"
+
+static bool write_source(size_t depth) {
+	FILE* file = fopen(
+		PATH_SOURCE,
+		"w");
+
+	if(file == NULL)
+		return false;
+
+	for(size_t i = 0;
+	i < depth;
+	i += 1) fprintf(file, "scope\n@x :u32 1;\n");
+
+	for(size_t i = 0;
+	i < depth;
+	i += 1) fprintf(file, ".\n");
+
+	fprintf(file, "\n");
+	return fclose(file) == 0;
+}
+
+static double seconds(void) {
+	struct timespec time;
+	clock_gettime(
+		CLOCK_MONOTONIC,
+		&time);
+	return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+int main(
+int argc,
+char** argv) {
+	// the parsing is measured, not the cache files
+	unsetenv("KEL_CACHE");
+	const size_t depth_max = argc > 1 ? strtoul(argv[1], NULL, 10) : 64000;
+	printf("depth\tseconds\tns/scope\n");
+
+	for(size_t depth = 1000;
+	depth <= depth_max;
+	depth *= 2) {
+		Source source;
+		MemoryArea memArea;
+		Interner interner;
+		Lexer lexer;
+		Parser parser;
+		initialize_source(&source);
+		initialize_memory_area(&memArea);
+		initialize_interner(&interner);
+		initialize_lexer(&lexer);
+		initialize_parser(&parser);
+
+		if(!write_source(depth)
+		|| !create_source(PATH_SOURCE, &source)
+		|| !create_memory_area((size_t) source.length, sizeof(uint8_t), &memArea)
+		|| !create_interner(CAPACITY_INTERNER, &interner)
+		|| !create_lexer(&source, &interner, &memArea, &lexer)) {
+			fprintf(stderr, "cannot tokenize a depth of %zu\n", depth);
+			return EXIT_FAILURE;
+		}
+
+		const double start = seconds();
+		const bool status = create_parser(
+			&lexer,
+			&parser);
+		const double time = seconds() - start;
+
+		if(!status) {
+			fprintf(stderr, "cannot parse a depth of %zu\n", depth);
+			return EXIT_FAILURE;
+		}
+
+		printf(
+			"%zu\t%.4f\t%.0f\n",
+			depth,
+			time,
+			time * 1e9 / (double) depth);
+		destroy_parser(&parser);
+		destroy_lexer(&lexer);
+		destroy_interner(&interner);
+		destroy_memory_area(&memArea);
+		destroy_source(&source);
+	}
+
+	remove(PATH_SOURCE);
+	return EXIT_SUCCESS;
+}
+
+#undef PATH_SOURCE
@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "kel.h"
+#include "parser_allocator.h"
+
+/*
+ * throughput of the parser on short instructions of every kind: "statement_bench [count] [runs]"
+ * the time is spent choosing the construct of each instruction rather than in long ones
+ * the tokens are parsed again at each run without the AST cache nor the threads
+*/
+
+#define PATH_SOURCE "/tmp/kel_statement_bench.kl"
+
+static bool write_source(size_t count) {
+	FILE* file = fopen(
+		PATH_SOURCE,
+		"w");
+
+	if(file == NULL)
+		return false;
+
+	fprintf(file, "imod sys, io.file;\n");
+
+	for(size_t i = 0;
+	i < count;
+	i += 1) fprintf(
+		file,
+		"@v%zu :u32 %zu;\n"
+		"[mut] @w%zu :u32;\n"
+		"#l%zu :scope scope\n"
+		"\t@x :u32 v%zu;\n"
+		"\tscope\n"
+		"\t\tl%zu;\n"
+		"\t.\n"
+		"\tl%zu.\n",
+		i,
+		i + 1,
+		i,
+		i,
+		i,
+		i,
+		i);
+
+	return fclose(file) == 0;
+}
+
+static double seconds(void) {
+	struct timespec time;
+	clock_gettime(
+		CLOCK_MONOTONIC,
+		&time);
+	return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+int main(
+int argc,
+char** argv) {
+	// the parsing is measured, not the cache files
+	unsetenv("KEL_CACHE");
+	const size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+	const size_t runs = argc > 2 ? strtoul(argv[2], NULL, 10) : 10;
+	Source source;
+	MemoryArea memArea;
+	Interner interner;
+	Lexer lexer;
+	initialize_source(&source);
+	initialize_memory_area(&memArea);
+	initialize_interner(&interner);
+	initialize_lexer(&lexer);
+
+	if(!write_source(count)
+	|| !create_source(PATH_SOURCE, &source)
+	|| !create_memory_area((size_t) source.length, sizeof(uint8_t), &memArea)
+	|| !create_interner(CAPACITY_INTERNER, &interner)
+	|| !create_lexer(&source, &interner, &memArea, &lexer)) {
+		fprintf(stderr, "cannot tokenize %zu groups of instructions\n", count);
+		return EXIT_FAILURE;
+	}
+
+	printf("run\tseconds\tMtokens/s\tns/node\n");
+
+	for(size_t run = 0;
+	run < runs;
+	run += 1) {
+		Parser parser;
+		initialize_parser(&parser);
+		parser.lexer = &lexer;
+
+		const double start = seconds();
+		const bool status = parser_create_allocators(&parser)
+		                 && parser_parse_tokens(
+			1,
+			lexer.tokens.count - 1,
+			&parser);
+		const double time = seconds() - start;
+
+		if(!status) {
+			fprintf(stderr, "cannot parse %zu groups of instructions\n", count);
+			return EXIT_FAILURE;
+		}
+
+		printf(
+			"%zu\t%.4f\t%.1f\t%.1f\n",
+			run,
+			time,
+			(double) lexer.tokens.count * 1e-6 / time,
+			time * 1e9 / (double) parser.count_nodes);
+		destroy_parser(&parser);
+	}
+
+	destroy_lexer(&lexer);
+	destroy_interner(&interner);
+	destroy_memory_area(&memArea);
+	destroy_source(&source);
+	remove(PATH_SOURCE);
+	return EXIT_SUCCESS;
+}
+
+#undef PATH_SOURCE
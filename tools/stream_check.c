@@ -0,0 +1,218 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kel.h"
+
+/*
+ * the tokens of a stream must be the ones of `create_lexer` whatever the window: "stream_check [file...]"
+ * a generated source without file, long enough for the window to drop its tokens many times
+ * each token is read through every window holding it, the tokens before the current one being released
+ * the error of the lexer being global, the files after one which cannot be tokenized are not checked
+*/
+
+#define PATH_SOURCE "/tmp/kel_stream_check.kl"
+#define COUNT_GROUP 2000
+
+static const size_t lookaheads[] = {1, 2, 3, 8, 64};
+
+// names, strings, numbers and nested parentheses in every group
+static bool write_source(void) {
+	FILE* file = fopen(
+		PATH_SOURCE,
+		"w");
+
+	if(file == NULL)
+		return false;
+
+	fprintf(file, "imod sys, io.file;\n");
+
+	for(size_t i = 0;
+	i < COUNT_GROUP;
+	i += 1) fprintf(
+		file,
+		"@v%zu :u32 %zu;\n"
+		"[mut] @w%zu :u32 (v%zu + 0x%zX) * p%zu(v%zu, (2 + v%zu));\n"
+		"#p%zu :B(c :A, d :A) scope\n"
+		"\tsys.out `string %zu`;\n"
+		"\t@q :u32 p%zu(c, d) + c.\n",
+		i,
+		i + 1,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i,
+		i);
+
+	return fclose(file) == 0;
+}
+
+static bool is_same_token(
+const Token* token,
+const Lexer* stream,
+const Token* expected,
+const Lexer* lexer) {
+	if(memcmp(
+		token,
+		expected,
+		sizeof(Token))
+	!= 0)
+		return false;
+	// the names are in the pool of each lexer, interned once
+	const LiteralString* strings = (const LiteralString*) stream->strings.addr;
+	const LiteralString* strings_expected = (const LiteralString*) lexer->strings.addr;
+	return (token->L_name == 0
+	     || strings[token->L_name].id == strings_expected[token->L_name].id)
+	    && (token->R_name == 0
+	     || strings[token->R_name].id == strings_expected[token->R_name].id);
+}
+
+// the number of drops of the window, -1 if a token differs or the stream fails
+static long int check_stream(
+const Source* source,
+Interner* interner,
+size_t lookahead,
+const Lexer* lexer) {
+	const Token* tokens = (const Token*) lexer->tokens.addr;
+	// the last token of `create_lexer` is the null one
+	const size_t count = lexer->tokens.count - 1;
+	MemoryArea memArea;
+	Lexer stream;
+	initialize_memory_area(&memArea);
+	initialize_lexer(&stream);
+	long int count_drops = -1;
+
+	if(!create_memory_area((size_t) source->length, sizeof(uint8_t), &memArea)
+	|| !create_lexer_stream(source, interner, &memArea, lookahead, &stream))
+		goto END;
+
+	size_t offset = 0;
+	long int drops = 0;
+
+	for(size_t i = 1;
+	i <= count;
+	i += 1) {
+		for(size_t j = i;
+		j < i + lookahead;
+		j += 1) {
+			const Token* token = lexer_stream_get(
+				j,
+				&stream);
+			// past the end, the stream returns its null token
+			const size_t k = j < count ? j : count;
+
+			if(token == NULL
+			|| !is_same_token(
+				token,
+				&stream,
+				tokens + k,
+				lexer)) {
+				fprintf(stderr, "token %zu differs with a window of %zu\n", k, lookahead);
+				goto END;
+			}
+
+			if(stream.stream_offset != offset) {
+				offset = stream.stream_offset;
+				drops += 1;
+			}
+		}
+
+		lexer_stream_release(
+			i + 1,
+			&stream);
+	}
+
+	count_drops = drops;
+END:
+	destroy_lexer(&stream);
+	destroy_memory_area(&memArea);
+	return count_drops;
+}
+
+// return 0 if the tokens differ, -1 if the file cannot be tokenized
+static int check(
+const char* path,
+bool is_dropping) {
+	Source source;
+	MemoryArea memArea;
+	Interner interner;
+	Lexer lexer;
+	initialize_source(&source);
+	initialize_memory_area(&memArea);
+	initialize_interner(&interner);
+	initialize_lexer(&lexer);
+	int status = -1;
+
+	if(!create_source(path, &source)
+	|| !create_memory_area((size_t) source.length, sizeof(uint8_t), &memArea)
+	|| !create_interner(CAPACITY_INTERNER, &interner)
+	|| !create_lexer(&source, &interner, &memArea, &lexer)) {
+		fprintf(stderr, "%s: cannot be tokenized\n", path);
+		goto END;
+	}
+
+	status = 1;
+
+	for(size_t i = 0;
+	i < sizeof(lookaheads) / sizeof(*lookaheads);
+	i += 1) {
+		const long int count_drops = check_stream(
+			&source,
+			&interner,
+			lookaheads[i],
+			&lexer);
+		// a window never dropped checks nothing of the ring
+		const bool is_same = count_drops > 0
+		                  || (count_drops == 0 && !is_dropping);
+		printf(
+			"%s: %zu tokens, window of %zu, %ld drops: %s\n",
+			path,
+			lexer.tokens.count - 1,
+			lookaheads[i],
+			count_drops,
+			is_same ? "same" : "DIFFERENT");
+
+		if(!is_same)
+			status = 0;
+	}
+END:
+	destroy_lexer(&lexer);
+	destroy_interner(&interner);
+	destroy_memory_area(&memArea);
+	destroy_source(&source);
+	return status;
+}
+
+int main(
+int argc,
+char** argv) {
+	// the tokens are read from the source, not from the cache files
+	unsetenv("KEL_CACHE");
+	bool is_same = true;
+
+	if(argc < 2) {
+		if(!write_source()) {
+			fprintf(stderr, "cannot write %s\n", PATH_SOURCE);
+			return EXIT_FAILURE;
+		}
+
+		is_same = check(PATH_SOURCE, true) == 1;
+		remove(PATH_SOURCE);
+	}
+
+	for(int i = 1;
+	i < argc;
+	i += 1) {
+		if(check(argv[i], false) != 1)
+			is_same = false;
+	}
+
+	return is_same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#undef COUNT_GROUP
+#undef PATH_SOURCE